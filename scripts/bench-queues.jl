@@ -0,0 +1,96 @@
+# Compares the throughput of B+'s lock-free queues against Julia's `Channel`.
+# Run with several threads for meaningful results, e.x. `julia -t 4 scripts/bench-queues.jl`.
+
+cd(joinpath(@__DIR__, ".."))
+insert!(LOAD_PATH, 1, ".")
+
+using Bplus.Utilities
+
+const N_ELEMENTS = 2_000_000
+const CAPACITY = 1024
+const BATCH_SIZE = 64
+
+function bench_channel(n_producers::Int, n_consumers::Int)
+    c = Channel{Int}(CAPACITY)
+    per_producer = N_ELEMENTS ÷ n_producers
+    return @elapsed begin
+        producers = [ Threads.@spawn(for i in 1:per_producer
+                                         put!(c, i)
+                                     end)
+                      for _ in 1:n_producers ]
+        consumers = [ Threads.@spawn(for _ in 1:(per_producer * n_producers ÷ n_consumers)
+                                         take!(c)
+                                     end)
+                      for _ in 1:n_consumers ]
+        foreach(wait, producers)
+        foreach(wait, consumers)
+    end
+end
+
+function bench_queue(q, n_producers::Int, n_consumers::Int)
+    per_producer = N_ELEMENTS ÷ n_producers
+    per_consumer = (per_producer * n_producers) ÷ n_consumers
+    return @elapsed begin
+        producers = [ Threads.@spawn(for i in 1:per_producer
+                                         while !try_push!(q, i)
+                                             yield()
+                                         end
+                                     end)
+                      for _ in 1:n_producers ]
+        consumers = [ Threads.@spawn(for _ in 1:per_consumer
+                                         while isnothing(try_pop!(q))
+                                             yield()
+                                         end
+                                     end)
+                      for _ in 1:n_consumers ]
+        foreach(wait, producers)
+        foreach(wait, consumers)
+    end
+end
+
+function bench_queue_batched(q, n_producers::Int, n_consumers::Int)
+    per_producer = N_ELEMENTS ÷ n_producers
+    per_consumer = (per_producer * n_producers) ÷ n_consumers
+    return @elapsed begin
+        producers = [ Threads.@spawn begin
+                          batch = collect(1:BATCH_SIZE)
+                          n_pushed = 0
+                          while n_pushed < per_producer
+                              n = try_push_batch!(q, @view batch[1:min(BATCH_SIZE, per_producer - n_pushed)])
+                              (n == 0) && yield()
+                              n_pushed += n
+                          end
+                      end
+                      for _ in 1:n_producers ]
+        consumers = [ Threads.@spawn begin
+                          batch = zeros(Int, BATCH_SIZE)
+                          n_popped = 0
+                          while n_popped < per_consumer
+                              n = try_pop_batch!(q, batch, min(BATCH_SIZE, per_consumer - n_popped))
+                              (n == 0) && yield()
+                              n_popped += n
+                          end
+                      end
+                      for _ in 1:n_consumers ]
+        foreach(wait, producers)
+        foreach(wait, consumers)
+    end
+end
+
+report(name, seconds) = println(rpad(name, 32), round(N_ELEMENTS / seconds / 1e6, digits=2), " M elements/s")
+
+println("Using ", Threads.nthreads(), " threads, ", N_ELEMENTS, " elements")
+for (n_producers, n_consumers) in ((1, 1), (2, 2), (4, 4))
+    println("\n", n_producers, " producer(s), ", n_consumers, " consumer(s):")
+    # Run each benchmark twice, so the first run can absorb the JIT cost.
+    for _ in 1:2; bench_channel(n_producers, n_consumers); end
+    report("Channel", bench_channel(n_producers, n_consumers))
+    if n_producers == n_consumers == 1
+        for _ in 1:2; bench_queue(SpscQueue{Int}(CAPACITY), 1, 1); end
+        report("SpscQueue", bench_queue(SpscQueue{Int}(CAPACITY), 1, 1))
+        report("SpscQueue (batched)", bench_queue_batched(SpscQueue{Int}(CAPACITY), 1, 1))
+    end
+    for _ in 1:2; bench_queue(MpmcQueue{Int}(CAPACITY), n_producers, n_consumers); end
+    report("MpmcQueue", bench_queue(MpmcQueue{Int}(CAPACITY), n_producers, n_consumers))
+    report("MpmcQueue (batched)", bench_queue_batched(MpmcQueue{Int}(CAPACITY), n_producers, n_consumers))
+end
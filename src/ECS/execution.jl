@@ -6,7 +6,7 @@ function tick_components(world::World, ::Type{T}) where {T<:AbstractComponent}
     return nothing
 end
 
-function tick_world(world::World, delta_seconds::Float32)
+@bp_profile "tick_world" function tick_world(world::World, delta_seconds::Float32)
     # Handle timing.
     if world.time_scale <= 0
         return nothing
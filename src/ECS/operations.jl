@@ -102,6 +102,7 @@ function add_component(e::Entity, ::Type{T},
     # Finally, construct the desired component and add it to all the lookups.
     component::T = create_component(T, e, args...; kw_args...)
     TReal = typeof(component) # T may be abstract
+    track_memory!(:ecs_components, sizeof(TReal))
     push!(e.components, component)
     for super_T in get_component_types(TReal)
         push!(get!(() -> Set{AbstractComponent}(),
@@ -159,6 +160,7 @@ function remove_component(e::Entity, c::AbstractComponent
 
     # Let it know about the destruction.
     destroy_component(c, e, entity_is_dying)
+    untrack_memory!(:ecs_components, sizeof(T))
 
     return nothing
 end
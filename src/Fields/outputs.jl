@@ -1,17 +1,21 @@
-"Fills an array by sampling the given field."
-function sample_field!( array::Array{Vec{NOut, F}, NIn},
-                        field::TField
-                        ;
-                        use_threading::Bool = true,
-                        array_bounds::Box{NIn, UInt} = Box(
-                            min = one(Vec{NIn, UInt}),
-                            size = convert(Vec{NIn, UInt}, vsize(array))
-                        ),
-                        sample_space::Box{NIn, F} = Box(
-                            min = zero(Vec{NIn, F}),
-                            max = one(Vec{NIn, F})
-                        )
-                      ) where {NIn, NOut, F, TField<:AbstractField{NIn, NOut, F}}
+"
+Fills an array by sampling the given field.
+If a `JobPool` is given, the work is split across its workers instead of using `Threads.@threads`.
+"
+@bp_profile "sample_field!" function sample_field!( array::Array{Vec{NOut, F}, NIn},
+                                                    field::TField
+                                                    ;
+                                                    use_threading::Bool = true,
+                                                    job_pool::Optional{JobPool} = nothing,
+                                                    array_bounds::Box{NIn, UInt} = Box(
+                                                        min = one(Vec{NIn, UInt}),
+                                                        size = convert(Vec{NIn, UInt}, vsize(array))
+                                                    ),
+                                                    sample_space::Box{NIn, F} = Box(
+                                                        min = zero(Vec{NIn, F}),
+                                                        max = one(Vec{NIn, F})
+                                                    )
+                                                  ) where {NIn, NOut, F, TField<:AbstractField{NIn, NOut, F}}
     prep_data = prepare_field(field)
 
     # Calculate field positions.
@@ -38,7 +42,9 @@ function sample_field!( array::Array{Vec{NOut, F}, NIn},
         end
         return nothing
     end
-    if use_threading
+    if use_threading && exists(job_pool)
+        parallel_for(process_slice, job_pool, b_min[NIn] : b_max[NIn])
+    elseif use_threading
         Threads.@threads for i::UInt in b_min[NIn] : b_max[NIn]
             process_slice(i)
         end
@@ -60,6 +66,10 @@ function sample_field( grid_size::Vec{NIn, <:Integer},
                        kw...
                      )::Array{Vec{NOut, F}, NIn} where {NIn, NOut, F}
     output = Array{Vec{NOut, F}, NIn}(undef, grid_size.data)
+    if bp_memory_tracking_enabled()
+        track_memory!(:fields_outputs, sizeof(output))
+        finalizer(a -> untrack_memory!(:fields_outputs, sizeof(a)), output)
+    end
     sample_field!(output, field; kw...)
     return output
 end
@@ -3,6 +3,7 @@ module GL
 
 using Setfield, TupleTools, MacroTools, StructTypes
 using ModernGLbp, GLFW, CSyntax
+using CRC32c
 using ..Utilities, ..Math
 
 @decentralized_module_init
@@ -39,6 +40,7 @@ include("context.jl")
 include("resource.jl")
 
 include("buffers/buffer.jl")
+include("buffers/streaming_buffer.jl")
 include("buffers/vertices.jl")
 include("buffers/mesh.jl")
 
@@ -49,6 +51,9 @@ include("textures/cube.jl")
 include("textures/views.jl")
 include("textures/view_debugging.jl")
 include("textures/texture.jl")
+include("textures/upload.jl")
+
+include("readback.jl")
 
 include("targets/target_buffer.jl")
 include("targets/target_output.jl")
@@ -1,3 +1,16 @@
+# Ways a Buffer can be persistently mapped into CPU memory.
+@bp_enum(BufferMapModes,
+    # The buffer is not mapped.
+    none,
+    # The buffer is mapped, and CPU writes become visible to the GPU automatically.
+    coherent,
+    # The buffer is mapped, and CPU writes only become visible to the GPU
+    #    after calling `flush_mapped_buffer()` on the written range.
+    # This can be faster than coherent mapping on some drivers.
+    explicit_flush
+)
+export BufferMapModes, E_BufferMapModes
+
 """
 A contiguous block of memory on the GPU,
    for storing any kind of data.
@@ -5,25 +18,36 @@ Most commonly used to store mesh vertices/indices, or other arrays of things.
 
 For help with uploading a whole data structure to a buffer, see `@std140` and `@std430`.
 
-UNIMPLEMENTED: Instances can be "mapped" to the CPU, allowing you to write/read them directly
-   as if they were a plain C array.
+Instances can be persistently "mapped" to the CPU by passing a `map_mode`,
+   allowing you to write/read them directly as if they were a plain Julia array
+   (see `get_mapped_array()`).
 This is often more efficient than setting the buffer data the usual way,
    e.x. you could read the mesh data from disk directly into this mapped memory.
+Note that it's up to you to avoid writing into memory the GPU is still using;
+   see `GLFence` and `StreamingBuffer`.
 """
 mutable struct Buffer <: AbstractResource
     handle::Ptr_Buffer
     byte_size::UInt64
     is_mutable_from_cpu::Bool
 
+    map_mode::E_BufferMapModes
+    mapped_ptr::Ptr{UInt8}
+
     function Buffer( byte_size::Integer, can_change_data_from_cpu::Bool,
                      recommend_storage_on_cpu::Bool = false
+                     ;
+                     map_mode::E_BufferMapModes = BufferMapModes.none,
+                     # If mapped, whether the CPU will read from the mapped memory.
+                     map_readable::Bool = false
                    )::Buffer
-        b = new(Ptr_Buffer(), 0, false)
+        b = new(Ptr_Buffer(), 0, false, BufferMapModes.none, C_NULL)
         set_up_buffer(
             byte_size, can_change_data_from_cpu,
             nothing,
             recommend_storage_on_cpu,
-            b
+            b,
+            map_mode, map_readable
         )
         return b
     end
@@ -35,17 +59,20 @@ mutable struct Buffer <: AbstractResource
                      contiguous_element_range::Interval{<:Integer} = Interval(
                         min=1,
                         size=contiguous_length(initial_elements, T)
-                     )
+                     ),
+                     map_mode::E_BufferMapModes = BufferMapModes.none,
+                     map_readable::Bool = false
                    )::Buffer where {T}
         @bp_check(isbitstype(T), "Can't make a GPU buffer of ", T)
-        b = new(Ptr_Buffer(), 0, false)
+        b = new(Ptr_Buffer(), 0, false, BufferMapModes.none, C_NULL)
         set_up_buffer(
             size(contiguous_element_range) * sizeof(T),
             can_change_data_from_cpu,
             contiguous_ref(initial_elements, T,
                            min_inclusive(contiguous_element_range)),
             recommend_storage_on_cpu,
-            b
+            b,
+            map_mode, map_readable
         )
         return b
     end
@@ -54,7 +81,9 @@ end
 @inline function set_up_buffer( byte_size::I, can_change_data_from_cpu::Bool,
                                 initial_byte_data::Optional{Ref},
                                 recommend_storage_on_cpu::Bool,
-                                output::Buffer
+                                output::Buffer,
+                                map_mode::E_BufferMapModes = BufferMapModes.none,
+                                map_readable::Bool = false
                               ) where {I<:Integer}
     @bp_check(exists(get_context()), "No Bplus Context to create this buffer in")
     handle::Ptr_Buffer = Ptr_Buffer(get_from_ogl(gl_type(Ptr_Buffer), glCreateBuffers, 1))
@@ -66,6 +95,21 @@ end
     if can_change_data_from_cpu
         flags |= GL_DYNAMIC_STORAGE_BIT
     end
+    map_flags::GLbitfield = 0
+    if map_mode != BufferMapModes.none
+        map_flags |= GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT
+        if map_readable
+            map_flags |= GL_MAP_READ_BIT
+        end
+        if map_mode == BufferMapModes.coherent
+            map_flags |= GL_MAP_COHERENT_BIT
+        end
+        # The flush bit is only allowed when mapping, not in the storage flags.
+        flags |= map_flags
+        if map_mode == BufferMapModes.explicit_flush
+            map_flags |= GL_MAP_FLUSH_EXPLICIT_BIT
+        end
+    end
 
     setfield!(output, :handle, handle)
     setfield!(output, :byte_size, UInt64(byte_size))
@@ -76,20 +120,36 @@ end
                              initial_byte_data :
                              C_NULL,
                          flags)
+    track_memory!(:gl_buffers, byte_size)
+
+    if map_mode != BufferMapModes.none
+        ptr = glMapNamedBufferRange(handle, 0, byte_size, map_flags)
+        @bp_check(ptr != C_NULL, "Failed to persistently map a Buffer of ", byte_size, " bytes")
+        setfield!(output, :map_mode, map_mode)
+        setfield!(output, :mapped_ptr, Ptr{UInt8}(ptr))
+    end
 end
 
 Base.show(io::IO, b::Buffer) = print(io,
     "Buffer<",
     Base.format_bytes(b.byte_size),
     (b.is_mutable_from_cpu ? " Mutable" : ""),
+    (b.map_mode != BufferMapModes.none ? " Mapped($(b.map_mode))" : ""),
     " ", b.handle,
     ">"
 )
 
 function Base.close(b::Buffer)
     h = b.handle
+    if h != Ptr_Buffer()
+        untrack_memory!(:gl_buffers, b.byte_size)
+        if b.mapped_ptr != C_NULL
+            glUnmapNamedBuffer(h)
+        end
+    end
     glDeleteBuffers(1, Ref{GLuint}(b.handle))
     setfield!(b, :handle, Ptr_Buffer())
+    setfield!(b, :mapped_ptr, Ptr{UInt8}(C_NULL))
 end
 
 export Buffer
@@ -210,6 +270,51 @@ end
 export set_buffer_data, get_buffer_data, copy_buffer
 
 
+"
+Gets a persistently-mapped buffer's memory as a Julia array, for reading/writing in-place.
+The array is only valid until the buffer is closed!
+Note that counts are per-element, not per-byte.
+"
+function get_mapped_array( b::Buffer,
+                           ::Type{T} = UInt8
+                           ;
+                           # The start of the array within the buffer
+                           byte_offset::Integer = 0,
+                           # The number of elements in the array (defaults to as many as possible)
+                           n_elements::Integer = (b.byte_size - byte_offset) ÷ sizeof(T)
+                         )::Vector{T} where {T}
+    @bp_check(isbitstype(T), "Can't map a buffer as an array of ", T)
+    @bp_check(b.mapped_ptr != C_NULL, "Buffer isn't mapped; pass a 'map_mode' when creating it")
+    @bp_check(byte_offset + (n_elements * sizeof(T)) <= b.byte_size,
+              "Trying to map past the end of the buffer: ",
+                "bytes ", byte_offset, " => ", byte_offset + (n_elements * sizeof(T)),
+                ", when there's only ", b.byte_size, " bytes")
+    @bp_check(byte_offset % Base.datatype_alignment(T) == 0,
+              "Byte offset ", byte_offset, " isn't aligned for ", T)
+    return unsafe_wrap(Array, Ptr{T}(b.mapped_ptr + byte_offset), n_elements; own=false)
+end
+
+"
+Makes CPU writes to a mapped buffer visible to the GPU.
+Only needed for buffers using `BufferMapModes.explicit_flush`.
+"
+function flush_mapped_buffer( b::Buffer
+                              ;
+                              byte_offset::Integer = 0,
+                              byte_size::Integer = b.byte_size - byte_offset
+                            )
+    @bp_check(b.map_mode == BufferMapModes.explicit_flush,
+              "Only explicit-flush buffers need to be flushed; this one is ", b.map_mode)
+    @bp_check(byte_offset + byte_size <= b.byte_size,
+              "Trying to flush past the end of the buffer")
+    if byte_size > 0
+        glFlushMappedNamedBufferRange(b.handle, byte_offset, byte_size)
+    end
+end
+
+export get_mapped_array, flush_mapped_buffer
+
+
 ###############################
 #       Automatic Layout      #
 ###############################
@@ -230,6 +230,12 @@ end
 
 function Base.close(m::Mesh)
     @bp_check(m.handle != Ptr_Mesh(), "Already closed this Mesh")
+    # Deleting the active VAO resets OpenGL's binding to 0; the Context must forget it too,
+    #    or a new Mesh which reuses this name would skip its first bind.
+    context = get_context()
+    if exists(context) && (context.active_mesh == m.handle)
+        setfield!(context, :active_mesh, Ptr_Mesh())
+    end
     glDeleteVertexArrays(1, Ref{GLuint}(m.handle))
     setfield!(m, :handle, Ptr_Mesh())
 end
@@ -0,0 +1,186 @@
+"
+A piece of a `StreamingBuffer`, handed out for one frame.
+Pass it to `set_uniform_block()` or `set_storage_block()`,
+    or use its `buffer` and `byte_range` directly (e.x. for vertex data).
+"
+struct StreamingAllocation
+    buffer::Buffer
+    # 1-based, like the `byte_range` parameter of `set_uniform_block()`.
+    byte_range::Interval{Int}
+end
+export StreamingAllocation
+
+"
+A persistently-mapped Buffer for data that changes every frame, like uniforms or instance data.
+The buffer is split into several regions (3 by default, for triple-buffering);
+    each frame writes into the next region, while the GPU may still be reading the older ones.
+Fences ensure a region is never overwritten until the GPU is done with it.
+
+Each frame, call `streaming_begin_frame!()`,
+    then any number of `streaming_allocate!()` or `streaming_push!()`,
+    then `streaming_end_frame!()` after issuing the draw calls which use that data.
+"
+mutable struct StreamingBuffer <: AbstractResource
+    buffer::Buffer
+    region_byte_size::Int
+    # Every allocation starts at a multiple of this many bytes.
+    alignment::Int
+    # The fence placed after each region's last use.
+    fences::Vector{Optional{GLFence}}
+
+    current_region::Int
+    current_byte_offset::Int
+    is_in_frame::Bool
+
+    # The number of times a frame had to wait for the GPU to finish with its region.
+    # If this keeps going up, consider adding more regions.
+    n_stalls::Int
+
+    function StreamingBuffer( region_byte_size::Integer
+                              ;
+                              n_regions::Integer = 3,
+                              # Defaults to the alignment required for both UBO's and SSBO's.
+                              alignment::Integer = let device = get_context().device
+                                  max(device.uniform_block_offset_alignment,
+                                      device.storage_block_offset_alignment)
+                              end,
+                              map_mode::E_BufferMapModes = BufferMapModes.coherent
+                            )
+        @bp_check(n_regions > 0, "Need at least one region")
+        @bp_check(alignment > 0, "Alignment must be positive")
+        @bp_check(map_mode != BufferMapModes.none, "A StreamingBuffer must be mapped")
+
+        # Round the region size up so that every region starts aligned.
+        region_byte_size = cld(region_byte_size, alignment) * alignment
+        return new(
+            Buffer(region_byte_size * n_regions, false; map_mode=map_mode),
+            region_byte_size, alignment,
+            fill(nothing, n_regions),
+            n_regions, 0, false,
+            0
+        )
+    end
+end
+
+get_ogl_handle(s::StreamingBuffer) = get_ogl_handle(s.buffer)
+is_destroyed(s::StreamingBuffer) = is_destroyed(s.buffer)
+
+function Base.close(s::StreamingBuffer)
+    for fence in s.fences
+        if exists(fence)
+            close(fence)
+        end
+    end
+    fill!(s.fences, nothing)
+    close(s.buffer)
+end
+
+Base.show(io::IO, s::StreamingBuffer) = print(io,
+    "StreamingBuffer<",
+    length(s.fences), "x", Base.format_bytes(s.region_byte_size),
+    ">"
+)
+
+export StreamingBuffer
+
+
+"
+Moves on to the next region of the buffer, waiting for the GPU to finish reading it if necessary.
+"
+function streaming_begin_frame!(s::StreamingBuffer)
+    @bp_check(!s.is_in_frame, "streaming_end_frame!() wasn't called for the previous frame")
+    region = mod1(s.current_region + 1, length(s.fences))
+    fence = s.fences[region]
+    if exists(fence)
+        if !is_fence_done(fence)
+            setfield!(s, :n_stalls, s.n_stalls + 1)
+            wait_for_fence(fence)
+        end
+        close(fence)
+        s.fences[region] = nothing
+    end
+
+    setfield!(s, :current_region, region)
+    setfield!(s, :current_byte_offset, 0)
+    setfield!(s, :is_in_frame, true)
+    return nothing
+end
+
+"
+Finishes writing to the current region.
+Call this after issuing all draw/compute calls that read this frame's allocations.
+"
+function streaming_end_frame!(s::StreamingBuffer)
+    @bp_check(s.is_in_frame, "streaming_begin_frame!() wasn't called")
+    if (s.buffer.map_mode == BufferMapModes.explicit_flush) && (s.current_byte_offset > 0)
+        flush_mapped_buffer(s.buffer;
+                            byte_offset = region_first_byte(s),
+                            byte_size = s.current_byte_offset)
+    end
+    s.fences[s.current_region] = GLFence()
+    setfield!(s, :is_in_frame, false)
+    return nothing
+end
+
+export streaming_begin_frame!, streaming_end_frame!
+
+
+"
+Reserves some bytes in the current frame's region.
+Write into them with `get_mapped_array()`.
+Throws an error if the region doesn't have enough space left.
+"
+function streaming_allocate!(s::StreamingBuffer, byte_size::Integer)::StreamingAllocation
+    @bp_check(s.is_in_frame, "streaming_begin_frame!() wasn't called")
+    @bp_check(s.current_byte_offset + byte_size <= s.region_byte_size,
+              "StreamingBuffer region is out of space: ",
+                s.current_byte_offset, " of ", s.region_byte_size, " bytes are already used, ",
+                "and ", byte_size, " more were requested")
+
+    first_byte = region_first_byte(s) + s.current_byte_offset
+    setfield!(s, :current_byte_offset,
+              min(s.region_byte_size,
+                  cld(s.current_byte_offset + byte_size, s.alignment) * s.alignment))
+    return StreamingAllocation(s.buffer, Interval{Int}(min=first_byte + 1, size=byte_size))
+end
+
+"Allocates space for the given data in the current frame's region, and copies it in"
+function streaming_push!(s::StreamingBuffer, data::T)::StreamingAllocation where {T}
+    @bp_check(isbitstype(T), "Can't stream data of type ", T)
+    a = streaming_allocate!(s, sizeof(T))
+    unsafe_store!(get_mapped_ptr(a, T), data)
+    return a
+end
+function streaming_push!(s::StreamingBuffer, data::AbstractVector{T})::StreamingAllocation where {T}
+    @bp_check(isbitstype(T), "Can't stream data of type ", T)
+    a = streaming_allocate!(s, sizeof(T) * length(data))
+    ptr = get_mapped_ptr(a, T)
+    if data isa Vector
+        GC.@preserve data unsafe_copyto!(ptr, pointer(data), length(data))
+    else
+        for (i, element) in enumerate(data)
+            unsafe_store!(ptr, element, i)
+        end
+    end
+    return a
+end
+
+export streaming_allocate!, streaming_push!
+
+
+"Gets an allocation's mapped memory as a Julia array, for writing into"
+get_mapped_array(a::StreamingAllocation, ::Type{T} = UInt8) where {T} = get_mapped_array(
+    a.buffer, T;
+    byte_offset = min_inclusive(a.byte_range) - 1,
+    n_elements = size(a.byte_range) ÷ sizeof(T)
+)
+
+
+"
+Internal helper that gets a pointer to an allocation's mapped memory.
+Unlike `get_mapped_array()`, it doesn't allocate.
+"
+get_mapped_ptr(a::StreamingAllocation, ::Type{T} = UInt8) where {T} =
+    Ptr{T}(a.buffer.mapped_ptr + min_inclusive(a.byte_range) - 1)
+
+region_first_byte(s::StreamingBuffer) = (s.current_region - 1) * s.region_byte_size
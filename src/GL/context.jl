@@ -34,6 +34,15 @@ struct Device
     # The name of the graphics device.
     # Can help you double-check that you didn't accidentally start on the integrated GPU.
     gpu_name::String
+    # The name of the company behind the graphics device.
+    gpu_vendor::String
+    # The full OpenGL version string, which usually includes the driver version.
+    driver_version::String
+
+    # Whether the driver can compile shaders on background threads
+    #    (the extension 'KHR_parallel_shader_compile').
+    # If not, `start_compile_program()` still works but compiles synchronously.
+    supports_parallel_shader_compile::Bool
 
     # Texture/sampler anisotropy can be between 1.0 and this value.
     max_anisotropy::Float32
@@ -58,6 +67,8 @@ struct Device
     max_uniform_blocks_in_vertex_shader::Int
     max_uniform_blocks_in_fragment_shader::Int
     #TODO: Other shader types
+    # The byte offset of a UBO's range within its buffer must be a multiple of this.
+    uniform_block_offset_alignment::Int
 
     # The number of available SSBO slots for programs to share.
     n_storage_block_slots::Int
@@ -65,6 +76,8 @@ struct Device
     max_storage_blocks_in_vertex_shader::Int
     max_storage_blocks_in_fragment_shader::Int
     #TODO: Other shader types
+    # The byte offset of an SSBO's range within its buffer must be a multiple of this.
+    storage_block_offset_alignment::Int
 
     # Driver hints about thresholds you should not cross or else performance gets bad:
     recommended_max_mesh_vertices::Int
@@ -80,6 +93,9 @@ function Device(window::GLFW.Window)
     return Device((GLFW.GetWindowAttrib(window, GLFW.CONTEXT_VERSION_MAJOR),
                    GLFW.GetWindowAttrib(window, GLFW.CONTEXT_VERSION_MINOR)),
                   unsafe_string(glGetString(GL_RENDERER)),
+                  unsafe_string(glGetString(GL_VENDOR)),
+                  unsafe_string(glGetString(GL_VERSION)),
+                  GLFW.ExtensionSupported("GL_KHR_parallel_shader_compile"),
                   get_from_ogl(GLfloat, glGetFloatv, GL_MAX_TEXTURE_MAX_ANISOTROPY),
                   v3u(get_from_ogl(GLint, glGetIntegeri_v, GL_MAX_COMPUTE_WORK_GROUP_SIZE, 0),
                       get_from_ogl(GLint, glGetIntegeri_v, GL_MAX_COMPUTE_WORK_GROUP_SIZE, 1),
@@ -94,9 +110,11 @@ function Device(window::GLFW.Window)
                   get_from_ogl(GLint, glGetIntegerv, GL_MAX_UNIFORM_BUFFER_BINDINGS),
                   get_from_ogl(GLint, glGetIntegerv, GL_MAX_VERTEX_UNIFORM_BLOCKS),
                   get_from_ogl(GLint, glGetIntegerv, GL_MAX_FRAGMENT_UNIFORM_BLOCKS),
+                  get_from_ogl(GLint, glGetIntegerv, GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT),
                   get_from_ogl(GLint, glGetIntegerv, GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS),
                   get_from_ogl(GLint, glGetIntegerv, GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS),
                   get_from_ogl(GLint, glGetIntegerv, GL_MAX_FRAGMENT_SHADER_STORAGE_BLOCKS),
+                  get_from_ogl(GLint, glGetIntegerv, GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT),
                   get_from_ogl(GLint, glGetIntegerv, GL_MAX_ELEMENTS_VERTICES),
                   get_from_ogl(GLint, glGetIntegerv, GL_MAX_ELEMENTS_INDICES),
                   get_from_ogl(GLint, glGetIntegerv, GL_MAX_COLOR_ATTACHMENTS),
@@ -104,6 +122,27 @@ function Device(window::GLFW.Window)
 end
 
 
+"
+Counts how many GL state changes were sent to OpenGL this frame,
+    versus skipped because the Context's cached state said they wouldn't change anything.
+"
+Base.@kwdef mutable struct StateChangeCounters
+    # Render state, e.x. blending or the viewport.
+    n_render_state_issued::Int = 0
+    n_render_state_skipped::Int = 0
+    # Shader program activation.
+    n_program_binds_issued::Int = 0
+    n_program_binds_skipped::Int = 0
+    # Mesh (vertex array) activation.
+    n_mesh_binds_issued::Int = 0
+    n_mesh_binds_skipped::Int = 0
+    # Uniform/storage block binding.
+    n_block_binds_issued::Int = 0
+    n_block_binds_skipped::Int = 0
+end
+export StateChangeCounters
+
+
 ############################
 #         Context          #
 ############################
@@ -130,6 +169,11 @@ mutable struct Context
     active_ubos::Vector{Tuple{Ptr_Buffer, Interval{Int}}} # Handle and byte range
     active_ssbos::Vector{Tuple{Ptr_Buffer, Interval{Int}}} # Handle and byte range
 
+    # Counts of issued vs skipped state changes, for the current and previous frame.
+    # See `reset_state_counters!()`.
+    state_counters::StateChangeCounters
+    last_frame_state_counters::StateChangeCounters
+
     # You can register any number of callbacks to GLFW events here.
     # Each is invoked with similar arguments to the raw callbacks minus the window handle.
     glfw_callbacks_mouse_button::Vector{Base.Callable} # (GLFW.MouseButton, GLFW.Action, Int)
@@ -196,6 +240,7 @@ mutable struct Context
                                 device.n_uniform_block_slots),
                            fill((Ptr_Buffer(), Interval{Int}(min=-1, max=-1)),
                                 device.n_storage_block_slots),
+                           StateChangeCounters(), StateChangeCounters(),
                            Vector{Base.Callable}(), Vector{Base.Callable}(),
                            Vector{Base.Callable}(), Vector{Base.Callable}(),
                            Vector{Base.Callable}(), Vector{Base.Callable}(),
@@ -263,6 +308,10 @@ mutable struct Context
                         unsafe_string(ModernGLbp.glGetString(GL_RENDERER)), "'.")
         end
 
+        if device.supports_parallel_shader_compile
+            enable_parallel_shader_compile()
+        end
+
         # Set up the OpenGL/window state.
         refresh(con)
         GLFW.SwapInterval(Int(con.vsync))
@@ -590,8 +639,8 @@ end
 export set_render_state
 
 function set_vsync(context::Context, sync::E_VsyncModes)
-    GLFW.SwapInterval(Int(context.vsync))
-    setfield(context, :vsync, sync)
+    GLFW.SwapInterval(Int(sync))
+    setfield!(context, :vsync, sync)
 end
 export set_vsync
 
@@ -604,13 +653,15 @@ function set_culling(context::Context, cull::E_FaceCullModes)
         else
             # Re-enable culling?
             if context.state.cull_mode == FaceCullModes.off
-                glEnable(GL_CULL_FACE_MODE)
+                glEnable(GL_CULL_FACE)
             end
             glCullFace(GLenum(cull))
         end
 
         # Update the context's fields.
         set_render_state_field!(context, :cull_mode, cull)
+    else
+        count_skipped_render_state!(context)
     end
 end
 set_render_state(::Val{:cull_mode}, val::E_FaceCullModes, c::Context) = set_culling(c, val)
@@ -621,6 +672,8 @@ function set_color_writes(context::Context, enabled::vRGBA{Bool})
     if context.state.color_write_mask != enabled
         glColorMask(enabled...)
         set_render_state_field!(context, :color_write_mask, enabled)
+    else
+        count_skipped_render_state!(context)
     end
 end
 set_render_state(::Val{:color_write_mask}, val::vRGBA{Bool}, c::Context) = set_color_writes(c, val)
@@ -631,6 +684,8 @@ function set_depth_test(context::Context, test::E_ValueTests)
     if context.state.depth_test != test
         glDepthFunc(GLenum(test))
         set_render_state_field!(context, :depth_test, test)
+    else
+        count_skipped_render_state!(context)
     end
 end
 set_render_state(::Val{:depth_test}, val::E_ValueTests, c::Context) = set_depth_test(c, val)
@@ -641,6 +696,8 @@ function set_depth_writes(context::Context, enabled::Bool)
     if context.state.depth_write != enabled
         glDepthMask(enabled)
         set_render_state_field!(context, :depth_write, enabled)
+    else
+        count_skipped_render_state!(context)
     end
 end
 set_render_state(::Val{:depth_write}, val::Bool, c::Context) = set_depth_writes(c, val)
@@ -663,6 +720,8 @@ function set_blending(context::Context, blend::BlendStateRGBA)
         glBlendColor(blend.constant...)
 
         set_render_state_field!(context, :blend_mode, new_blend)
+    else
+        count_skipped_render_state!(context)
     end
 end
 "Sets the blend mode for RGB channels, leaving Alpha unchanged"
@@ -677,6 +736,8 @@ function set_blending(context::Context, blend_rgb::BlendStateRGB)
             rgb = blend_rgb,
             alpha = context.state.blend_mode.alpha
         ))
+    else
+        count_skipped_render_state!(context)
     end
 end
 "Sets the blend mode for Alpha channels, leaving the RGB unchanged"
@@ -689,8 +750,10 @@ function set_blending(context::Context, blend_a::BlendStateAlpha)
         glBlendColor(blend_rgb.constant..., blend_a.constant)
         set_render_state_field!(context, :blend_mode, (
             rgb = context.state.blend_mode.rgb,
-            alpha = context.state.blend_mode.alpha
+            alpha = blend_a
         ))
+    else
+        count_skipped_render_state!(context)
     end
 end
 "Sets the blend mode for RGB and Alpha channels separately"
@@ -701,10 +764,9 @@ function set_blending(context::Context, blend_rgb::BlendStateRGB, blend_a::Blend
                             GLenum(blend_a.src), GLenum(blend_a.dest))
         glBlendEquationSeparate(GLenum(blend_rgb.op), GLenum(blend_a.op))
         glBlendColor(blend_rgb.constant..., blend_a.constant)
-        set_render_state_field!(context, :blend_mode, (
-            rgb = context.state.blend_mode.rgb,
-            alpha = blend_a
-        ))
+        set_render_state_field!(context, :blend_mode, new_blend)
+    else
+        count_skipped_render_state!(context)
     end
 end
 set_render_state(::Val{:blend_mode}, val::@NamedTuple{rgb::BlendStateRGB, alpha::BlendStateAlpha}, c::Context) =
@@ -715,7 +777,9 @@ export set_blending
 function set_stencil_test(context::Context, test::StencilTest)
     if context.state.stencil_test != test
         glStencilFunc(GLenum(test.test), test.reference, test.bitmask)
-        set_render_state_field!(context, stencil_test, test)
+        set_render_state_field!(context, :stencil_test, test)
+    else
+        count_skipped_render_state!(context)
     end
 end
 "Sets the stencil test to use for front-faces, leaving the back-faces test unchanged"
@@ -724,7 +788,9 @@ function set_stencil_test_front(context::Context, test::StencilTest)
         glStencilFuncSeparate(GL_FRONT, GLenum(test.test), test.reference, test.bitmask)
 
         current_back::StencilTest = get_stencil_test_back(context)
-        set_render_state_field!(context, stencil_test, (front=test, back=current_back))
+        set_render_state_field!(context, :stencil_test, (front=test, back=current_back))
+    else
+        count_skipped_render_state!(context)
     end
 end
 "Sets the stencil test to use for back-faces, leaving the front-faces test unchanged"
@@ -734,6 +800,8 @@ function set_stencil_test_back(context::Context, test::StencilTest)
 
         current_front::StencilTest = get_stencil_test_front(context)
         set_render_state_field!(context, :stencil_test, (front=current_front, back=test))
+    else
+        count_skipped_render_state!(context)
     end
 end
 "Sets the stencil test to use on front-faces and back-faces, separately"
@@ -755,6 +823,8 @@ function set_stencil_result(context::Context, ops::StencilResult)
                     GLenum(ops.on_passed_stencil_failed_depth),
                     GLenum(ops.on_passed_all))
         set_render_state_field!(context, :stencil_result, ops)
+    else
+        count_skipped_render_state!(context)
     end
 end
 "Sets the stencil operations to use on front-faces, based on the stencil and depth tests"
@@ -769,6 +839,8 @@ function set_stencil_result_front(context::Context, ops::StencilResult)
             front=ops,
             back=current_back_ops
         ))
+    else
+        count_skipped_render_state!(context)
     end
 end
 "Sets the stencil operations to use on back-faces, based on the stencil and depth tests"
@@ -783,6 +855,8 @@ function set_stencil_result_back(context::Context, ops::StencilResult)
             front=current_front_ops,
             back=ops
         ))
+    else
+        count_skipped_render_state!(context)
     end
 end
 "
@@ -802,6 +876,8 @@ function set_stencil_write_mask(context::Context, mask::GLuint)
     if context.state.stencil_write_mask != mask
         glStencilMask(mask)
         set_render_state_field!(context, :stencil_write_mask, mask)
+    else
+        count_skipped_render_state!(context)
     end
 end
 "
@@ -816,6 +892,8 @@ function set_stencil_write_mask_front(context::Context, mask::GLuint)
             front=mask,
             back=current_back_mask
         ))
+    else
+        count_skipped_render_state!(context)
     end
 end
 "
@@ -830,6 +908,8 @@ function set_stencil_write_mask_back(context::Context, mask::GLuint)
             front=current_front_mask,
             back=mask
         ))
+    else
+        count_skipped_render_state!(context)
     end
 end
 "
@@ -855,6 +935,8 @@ function set_viewport(context::Context, area::Box2Di)
     if context.state.viewport != area
         glViewport((min_inclusive(area) - 1)..., size(area)...)
         set_render_state_field!(context, :viewport, area)
+    else
+        count_skipped_render_state!(context)
     end
 end
 set_render_state(::Val{:viewport}, val::Box2Di, c::Context) = set_viewport(c, val)
@@ -880,12 +962,52 @@ function set_scissor(context::Context, area::Optional{Box2Di})
         end
 
         set_render_state_field!(context, :scissor, area)
+    else
+        count_skipped_render_state!(context)
     end
 end
 set_render_state(::Val{:scissor}, val::Optional{Box2Di}, c::Context) = set_scissor(c, val)
 export set_scissor
 
 
+"Activates the given shader program, unless it's already active"
+function set_active_program(context::Context, program::Ptr_Program)
+    if context.active_program != program
+        glUseProgram(program)
+        setfield!(context, :active_program, program)
+        context.state_counters.n_program_binds_issued += 1
+    else
+        context.state_counters.n_program_binds_skipped += 1
+    end
+end
+"Activates the given mesh (a.k.a. Vertex Array Object), unless it's already active"
+function set_active_mesh(context::Context, mesh::Ptr_Mesh)
+    if context.active_mesh != mesh
+        glBindVertexArray(mesh)
+        setfield!(context, :active_mesh, mesh)
+        context.state_counters.n_mesh_binds_issued += 1
+    else
+        context.state_counters.n_mesh_binds_skipped += 1
+    end
+end
+
+"
+Ends the current frame's count of issued vs skipped state changes,
+    moving it into `context.last_frame_state_counters` and starting a new count.
+`@game_loop` calls this for you once per frame.
+"
+function reset_state_counters!(context::Context)
+    last = context.last_frame_state_counters
+    current = context.state_counters
+    for f in fieldnames(StateChangeCounters)
+        setfield!(last, f, getfield(current, f))
+        setfield!(current, f, 0)
+    end
+    return last
+end
+export reset_state_counters!
+
+
 
 # Provide convenient versions of the above which get the context automatically.
 set_vsync(sync::E_VsyncModes) = set_vsync(get_context(), sync)
@@ -910,6 +1032,7 @@ set_stencil_write_mask_back(write_mask::GLuint) = set_stencil_write_mask_back(ge
 set_stencil_write_mask(front::GLuint, back::GLuint) = set_stencil_write_mask(get_context(), front, back)
 set_viewport(area::Box2Di) = set_viewport(get_context(), area)
 set_scissor(area::Optional{Box2Di}) = set_scissor(get_context(), area)
+reset_state_counters!() = reset_state_counters!(get_context())
 
 
 ##########################
@@ -981,7 +1104,7 @@ macro render_state_wrapper(signature, cache_old, set_new, set_old, description)
 end
 
 @render_state_wrapper(with_culling(cull::E_FaceCullModes),
-                      old_cull = context.cull_mode,
+                      old_cull = context.state.cull_mode,
                       set_culling(context, cull),
                       set_culling(context, old_cull),
                       "cull state")
@@ -1111,7 +1234,9 @@ end
 @inline function set_render_state_field!(c::Context, field::Symbol, value)
     rs = set(c.state, Setfield.PropertyLens{field}(), value)
     setfield!(c, :state, rs)
+    c.state_counters.n_render_state_issued += 1
 end
+@inline count_skipped_render_state!(c::Context) = (c.state_counters.n_render_state_skipped += 1)
 
 
 ####################################
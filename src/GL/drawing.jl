@@ -77,21 +77,21 @@ NOTE: There is one small, relatively-esoteric OpenGL feature that is not include
    (adding it would probably require separating this function into 3 different ones):
    indexed multi-draw could use different index offsets for each subset of elements.
 "
-function render_mesh( mesh::Mesh, program::Program
-                      ;
-                      #TODO: Can't do type inference with named parameters! This creates garbage and slowdown.
-                      shape::E_PrimitiveTypes = mesh.type,
-                      indexed_params::Optional{DrawIndexed} =
-                          exists(mesh.index_data) ? DrawIndexed() : nothing,
-                      elements::Union{IntervalU, TMultiDraw} = IntervalU((
-                          min=1,
-                          size=exists(indexed_params) ?
-                                   count_mesh_elements(mesh) :
-                                   count_mesh_vertices(mesh)
-                      )),
-                      instances::Optional{IntervalU} = nothing,
-                      known_vertex_range::Optional{IntervalU} = nothing
-                    ) where {TMultiDraw<:Union{AbstractVector{IntervalU}, ConstVector{IntervalU}}}
+@bp_profile "render_mesh" function render_mesh( mesh::Mesh, program::Program
+                                                ;
+                                                #TODO: Can't do type inference with named parameters! This creates garbage and slowdown.
+                                                shape::E_PrimitiveTypes = mesh.type,
+                                                indexed_params::Optional{DrawIndexed} =
+                                                    exists(mesh.index_data) ? DrawIndexed() : nothing,
+                                                elements::Union{IntervalU, TMultiDraw} = IntervalU((
+                                                    min=1,
+                                                    size=exists(indexed_params) ?
+                                                             count_mesh_elements(mesh) :
+                                                             count_mesh_vertices(mesh)
+                                                )),
+                                                instances::Optional{IntervalU} = nothing,
+                                                known_vertex_range::Optional{IntervalU} = nothing
+                                              ) where {TMultiDraw<:Union{AbstractVector{IntervalU}, ConstVector{IntervalU}}}
     context::Context = get_context()
     @bp_check(isnothing(indexed_params) || exists(mesh.index_data),
               "Trying to render with indexed_params but the mesh has no indices")
@@ -108,10 +108,8 @@ function render_mesh( mesh::Mesh, program::Program
     service_ViewDebugging_check(get_ogl_handle(program))
 
     # Activate the mesh and program.
-    glUseProgram(program.handle)
-    setfield!(context, :active_program, program.handle)
-    glBindVertexArray(mesh.handle)
-    setfield!(context, :active_mesh, mesh.handle)
+    set_active_program(context, program.handle)
+    set_active_mesh(context, mesh.handle)
 
     #=
      The notes I took when preparing the old C++ draw calls interface:
@@ -247,6 +245,145 @@ end
 export DrawIndexed, render_mesh
 
 
+"
+One indexed draw, laid out the way OpenGL reads it from a Buffer for indirect drawing.
+Unlike the rest of B+, the fields are 0-based, because the GPU reads them as-is
+    (and compute shaders may write them directly).
+Use the constructor with 1-based ranges for convenience.
+"
+struct DrawElementsIndirectCommand
+    count::GLuint
+    instance_count::GLuint
+    first_index::GLuint
+    # An offset added to every index (see `DrawIndexed.value_offset`).
+    base_vertex::GLint
+    base_instance::GLuint
+end
+DrawElementsIndirectCommand(elements::IntervalU
+                            ;
+                            instances::IntervalU = IntervalU(min=1, size=1),
+                            value_offset::Integer = 0) = DrawElementsIndirectCommand(
+    size(elements), size(instances),
+    min_inclusive(elements) - 1,
+    value_offset,
+    min_inclusive(instances) - 1
+)
+
+"
+One non-indexed draw, laid out the way OpenGL reads it from a Buffer for indirect drawing.
+Like `DrawElementsIndirectCommand`, the fields are 0-based.
+"
+struct DrawArraysIndirectCommand
+    count::GLuint
+    instance_count::GLuint
+    first_vertex::GLuint
+    base_instance::GLuint
+end
+DrawArraysIndirectCommand(elements::IntervalU
+                          ;
+                          instances::IntervalU = IntervalU(min=1, size=1)) = DrawArraysIndirectCommand(
+    size(elements), size(instances),
+    min_inclusive(elements) - 1,
+    min_inclusive(instances) - 1
+)
+
+"
+Renders a mesh many times in one call with the given shader program,
+    with the draw commands read from a Buffer on the GPU.
+The commands are `DrawElementsIndirectCommand` if the mesh is indexed,
+    or `DrawArraysIndirectCommand` otherwise.
+They can be written by the CPU, or by a compute shader
+    (in which case, call `gl_catch_up_before(MemoryActions.indirect_draw)` first).
+
+If `count_buffer` is given, the number of commands to draw is read from it on the GPU
+    (as a `GLuint` at `count_byte_offset`), and `n_commands` is an upper bound on it.
+This lets a compute shader do culling and decide how many objects to draw.
+
+Shaders can use `gl_DrawID` to tell the commands apart,
+    and `gl_BaseInstance` to find per-object data.
+"
+@bp_profile "render_mesh_indirect" function render_mesh_indirect( mesh::Mesh, program::Program,
+                                                                  commands::Buffer,
+                                                                  n_commands::Integer = commands.byte_size ÷ (
+                                                                      exists(mesh.index_data) ?
+                                                                          sizeof(DrawElementsIndirectCommand) :
+                                                                          sizeof(DrawArraysIndirectCommand)
+                                                                  )
+                                                                  ;
+                                                                  shape::E_PrimitiveTypes = mesh.type,
+                                                                  # See `DrawIndexed.reset_value`.
+                                                                  index_reset_value::Optional{GLuint} = nothing,
+                                                                  commands_byte_offset::Integer = 0,
+                                                                  # The byte distance between each command (0 means tightly-packed).
+                                                                  commands_byte_stride::Integer = 0,
+                                                                  count_buffer::Optional{Buffer} = nothing,
+                                                                  count_byte_offset::Integer = 0
+                                                                )
+    context::Context = get_context()
+    command_byte_size = exists(mesh.index_data) ?
+                            sizeof(DrawElementsIndirectCommand) :
+                            sizeof(DrawArraysIndirectCommand)
+    @bp_check(commands_byte_offset % 4 == 0,
+              "Indirect command offset must be a multiple of 4 bytes; got ", commands_byte_offset)
+    @bp_check((commands_byte_stride == 0) ||
+                ((commands_byte_stride >= command_byte_size) && (commands_byte_stride % 4 == 0)),
+              "Invalid stride for indirect commands: ", commands_byte_stride)
+    @bp_check(commands_byte_offset +
+                (n_commands * max(commands_byte_stride, command_byte_size)) <= commands.byte_size,
+              "Indirect command buffer is too small for ", n_commands, " commands")
+    @bp_check(isnothing(count_buffer) || (count_byte_offset % 4 == 0),
+              "Indirect count offset must be a multiple of 4 bytes; got ", count_byte_offset)
+    @bp_check(exists(mesh.index_data) || isnothing(index_reset_value),
+              "Gave an index reset value, but the mesh isn't indexed")
+
+    service_ViewDebugging_check(get_ogl_handle(program))
+
+    set_active_program(context, program.handle)
+    set_active_mesh(context, mesh.handle)
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, get_ogl_handle(commands))
+    if exists(count_buffer)
+        glBindBuffer(GL_PARAMETER_BUFFER, get_ogl_handle(count_buffer))
+    end
+
+    commands_ptr = Ptr{Cvoid}(commands_byte_offset)
+    if exists(mesh.index_data)
+        if exists(index_reset_value)
+            glEnable(GL_PRIMITIVE_RESTART)
+            glPrimitiveRestartIndex(index_reset_value)
+        else
+            glDisable(GL_PRIMITIVE_RESTART)
+        end
+        index_type = get_index_ogl_enum(mesh.index_data.type)
+        if exists(count_buffer)
+            glMultiDrawElementsIndirectCount(shape, index_type, commands_ptr,
+                                             count_byte_offset, n_commands,
+                                             commands_byte_stride)
+        else
+            glMultiDrawElementsIndirect(shape, index_type, commands_ptr,
+                                        n_commands, commands_byte_stride)
+        end
+    else
+        if exists(count_buffer)
+            glMultiDrawArraysIndirectCount(shape, commands_ptr,
+                                           count_byte_offset, n_commands,
+                                           commands_byte_stride)
+        else
+            glMultiDrawArraysIndirect(shape, commands_ptr,
+                                      n_commands, commands_byte_stride)
+        end
+    end
+
+    # Unbind the buffers, so later code doesn't accidentally read from them.
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, Ptr_Buffer())
+    if exists(count_buffer)
+        glBindBuffer(GL_PARAMETER_BUFFER, Ptr_Buffer())
+    end
+end
+
+export DrawElementsIndirectCommand, DrawArraysIndirectCommand, render_mesh_indirect
+
+
 ############################
 #     Compute Dispatch     #
 ############################
@@ -266,8 +403,7 @@ end
 function dispatch_compute_groups(program::Program, count::Vec3{<:Integer}
                                  ; context::Context = get_context())
     # Activate the program.
-    glUseProgram(get_ogl_handle(program))
-    setfield!(context, :active_program, get_ogl_handle(program))
+    set_active_program(context, get_ogl_handle(program))
 
     glDispatchCompute(convert(Vec{3, GLuint}, count)...)
 end
@@ -88,6 +88,10 @@ function set_uniforms end
 Sets the given buffer to be used for one of the
     globally-available Uniform Block (a.k.a. "UBO") slots.
 
+`set_uniform_block(::StreamingAllocation, ::Int)`
+
+Sets part of a `StreamingBuffer` to be used for one of the global UBO slots.
+
 `set_uniform_block(::Program, ::String, ::Int)`
 
 Sets a program's Uniform Block (a.k.a. "UBO")
@@ -107,6 +111,10 @@ function set_uniform_block end
 Sets the given buffer to be used for one of the
     globally-available Shader Storage Block (a.k.a. "SSBO") slots.
 
+`set_storage_block(::StreamingAllocation, ::Int)`
+
+Sets part of a `StreamingBuffer` to be used for one of the global SSBO slots.
+
 `set_storage_block(::Program, ::String, ::Int)`
 
 Sets a program's Shader-Storage Block (a.k.a. "SSBO")
@@ -143,13 +151,12 @@ export PreCompiledProgram
 #############################
 
 "
-Internal helper that compiles a single stage of a shader program.
-Returns the program's handle, or an error message.
+Internal helper that starts compiling a single stage of a shader program.
+Returns the shader's handle.
+Errors are checked later with `get_stage_error()`,
+    so that the driver can work on many stages and programs in parallel.
 "
-function compile_stage( name::String,
-                        type::GLenum,
-                        source::String
-                      )::Union{GLuint, String}
+function start_compile_stage(type::GLenum, source::String)::GLuint
     source = string(GLSL_HEADER, "\n", source)
     handle::GLuint = glCreateShader(type)
 
@@ -159,11 +166,20 @@ function compile_stage( name::String,
     source_array = [ convert(Ptr{GLchar}, pointer(source)) ]
     source_array_ptr = convert(Ptr{UInt8}, pointer(source_array))
 
-    glShaderSource(handle, 1, source_array_ptr, C_NULL)
+    GC.@preserve source source_array glShaderSource(handle, 1, source_array_ptr, C_NULL)
     glCompileShader(handle)
 
+    return handle
+end
+
+"
+Internal helper that checks whether a single stage of a shader program compiled successfully.
+Blocks until the driver has finished compiling it.
+Returns an error message, or `nothing` if it succeeded.
+"
+function get_stage_error(name::String, handle::GLuint)::Optional{String}
     if get_from_ogl(GLint, glGetShaderiv, handle, GL_COMPILE_STATUS) == GL_TRUE
-        return handle
+        return nothing
     else
         err_msg_len = get_from_ogl(GLint, glGetShaderiv, handle, GL_INFO_LOG_LENGTH)
         err_msg_data = Vector{UInt8}(undef, err_msg_len)
@@ -217,15 +233,173 @@ ProgramCompiler( src_compute::AbstractString
     cached_binary
 )
 
+
+################################
+#      ProgramBinaryCache      #
+################################
+
 "
-Run the given compile job.
-Returns the new program's handle, or a compile error message.
-Also optionally updates the compiler 'cached_binary' field to contain
-    the program's up-to-date binary blob.
+A directory of compiled program binaries, so that shaders don't have to be
+    recompiled every time the application starts.
+
+Each entry is keyed on the full shader source (including `GLSL_HEADER`)
+    plus the GPU vendor, renderer, and driver version,
+    so a driver update or a different GPU simply misses the cache.
+Pass it to the `Program` constructors with the `binary_cache` parameter,
+    or use `compile_program(::ProgramCompiler, ::ProgramBinaryCache)` directly.
+"
+struct ProgramBinaryCache
+    directory::String
+    function ProgramBinaryCache(directory::AbstractString)
+        mkpath(directory)
+        return new(string(directory))
+    end
+end
+export ProgramBinaryCache
+
+# The contents of one file in a ProgramBinaryCache.
+# The full key is stored alongside the binary so that hash collisions are detected.
+struct ProgramBinaryCacheEntry
+    device_key::String
+    source_key::String
+    format::GLenum
+    data::Vector{UInt8}
+end
+
+"Gets a string identifying the GPU and driver that compiled a program binary"
+function program_binary_device_key(device::Device = get_context().device)::String
+    return string(device.gpu_vendor, "\n",
+                  device.gpu_name, "\n",
+                  device.driver_version)
+end
+"Gets a string containing the exact shader source code that OpenGL sees"
+function program_binary_source_key(source::RenderProgramSource)::String
+    return string(GLSL_HEADER,
+                  "\n#START_VERTEX\n", source.src_vertex,
+                  "\n#START_FRAGMENT\n", source.src_fragment,
+                  exists(source.src_geometry) ? string("\n#START_GEOMETRY\n", source.src_geometry) : "")
+end
+program_binary_source_key(source::ComputeProgramSource)::String = string(
+    GLSL_HEADER,
+    "\n#START_COMPUTE\n", source.src
+)
+
+"Gets the file in the cache that a program's binary would be stored in"
+function program_binary_path(cache::ProgramBinaryCache, device_key::String, source_key::String)::String
+    hash = crc32c(source_key, crc32c(device_key))
+    return joinpath(cache.directory, string(string(hash, base=16, pad=8), ".bin"))
+end
+
+"
+Loads a program's binary from the cache, or returns `nothing` if it's missing or stale.
+Must be called on the GL thread.
 "
-function compile_program( p::ProgramCompiler,
-                          update_cache::Bool = false
-                        )::Union{Ptr_Program, String}
+function load_program_binary(cache::ProgramBinaryCache, p::ProgramCompiler)::Optional{PreCompiledProgram}
+    device_key = program_binary_device_key()
+    source_key = program_binary_source_key(p.source)
+    path = program_binary_path(cache, device_key, source_key)
+    if !isfile(path)
+        return nothing
+    end
+
+    # A corrupt or outdated file is treated as a miss; it'll be overwritten after recompiling.
+    entry = try
+        read_binary(path, ProgramBinaryCacheEntry)
+    catch e
+        @warn "Failed to read a cached program binary from '$path'" exception=e
+        return nothing
+    end
+    if (entry.device_key != device_key) || (entry.source_key != source_key)
+        return nothing
+    end
+    return PreCompiledProgram(entry.format, entry.data)
+end
+
+"
+Writes the compiler's `cached_binary` into the cache.
+Must be called on the GL thread.
+"
+function save_program_binary(cache::ProgramBinaryCache, p::ProgramCompiler)
+    @bp_check(exists(p.cached_binary), "The ProgramCompiler has no binary to save")
+    device_key = program_binary_device_key()
+    source_key = program_binary_source_key(p.source)
+    path = program_binary_path(cache, device_key, source_key)
+
+    # Write to a temp file first, so that a crash never leaves a half-written entry.
+    temp_path = string(path, ".tmp")
+    write_binary(temp_path, ProgramBinaryCacheEntry(device_key, source_key,
+                                                    p.cached_binary.header,
+                                                    p.cached_binary.data))
+    mv(temp_path, path; force=true)
+    return nothing
+end
+
+export load_program_binary, save_program_binary
+
+
+###############################
+#      ProgramCompileJob      #
+###############################
+
+# Drivers with the extension 'KHR_parallel_shader_compile' compile shaders on background threads,
+#    and let us ask whether a program is finished without blocking.
+# ModernGLbp doesn't expose this extension, so its enum and function are loaded by hand.
+# Whether it's supported is stored in `Device::supports_parallel_shader_compile`.
+const GL_COMPLETION_STATUS_KHR = GLenum(0x91B1)
+
+"
+Internal helper that lets the driver use as many compiler threads as it wants.
+Only call this if the extension 'KHR_parallel_shader_compile' is supported.
+"
+function enable_parallel_shader_compile()
+    proc = GLFW.GetProcAddress("glMaxShaderCompilerThreadsKHR")
+    if proc != C_NULL
+        # 0xFFFFFFFF means "implementation-defined maximum".
+        ccall(proc, Cvoid, (GLuint, ), typemax(GLuint))
+    end
+end
+
+"
+A program which is compiling in the background.
+Start one with `start_compile_program()`, poll it with `is_compile_done()`,
+    then get the result with `finish_compile_program()` (or the `Program` constructor).
+Every job must be finished (or `close()`-d to abandon it), or else its OpenGL objects will leak.
+
+Submitting many jobs up-front, then finishing them as they complete,
+    lets the driver compile them in parallel
+    (if it supports the extension 'KHR_parallel_shader_compile').
+Otherwise, each job effectively compiles when it's finished.
+"
+mutable struct ProgramCompileJob
+    compiler::ProgramCompiler
+    update_cache::Bool
+    binary_cache::Optional{ProgramBinaryCache}
+    # The binary which was loaded from the cache, if any.
+    loaded_binary::Optional{PreCompiledProgram}
+
+    handle::Ptr_Program
+    # The individual shaders being compiled, paired with their names for error messages.
+    # Empty if the program was created from a binary.
+    stages::Vector{Tuple{String, GLuint}}
+    # False if linking was deferred until the job is finished.
+    is_linked::Bool
+
+    is_finished::Bool
+end
+export ProgramCompileJob
+
+"
+Starts compiling the given program, without waiting for the result.
+Optionally updates the compiler's `cached_binary` field once it's finished
+    (see `compile_program()`).
+Must be called on the GL thread.
+
+If `link_eagerly` is false, the program isn't linked until the job is finished,
+    and is never linked if a stage failed to compile.
+This is only useful when finishing the job right away, as it prevents background compilation.
+"
+function start_compile_program(p::ProgramCompiler, update_cache::Bool = false
+                               ; link_eagerly::Bool = true)::ProgramCompileJob
     @bp_check(exists(get_context()), "Can't create a Program outside a Bplus.GL.Context")
 
     out_ptr = Ptr_Program(glCreateProgram())
@@ -236,49 +410,108 @@ function compile_program( p::ProgramCompiler,
                         Ref(p.cached_binary.data, 1),
                         length(p.cached_binary.data))
 
-        if get_from_ogl(GLint, glGetProgramiv, GL_LINK_STATUS) == GL_TRUE
-            return out_ptr
+        if get_from_ogl(GLint, glGetProgramiv, out_ptr, GL_LINK_STATUS) == GL_TRUE
+            return ProgramCompileJob(p, update_cache, nothing, nothing,
+                                     out_ptr, Tuple{String, GLuint}[ ], true, false)
         end
+
+        # The binary was rejected (e.x. after a driver update).
+        # Start over with a fresh program object.
+        glDeleteProgram(out_ptr)
+        out_ptr = Ptr_Program(glCreateProgram())
     end
 
-    # Compile the individual shaders.
-    compiled_handles::Vector{GLuint} = [ ]
+    # Ask the driver to keep the program's binary around so we can read it back.
+    if update_cache
+        glProgramParameteri(out_ptr, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE)
+    end
+
+    # Start compiling the individual shaders.
+    stages = Tuple{String, GLuint}[ ]
     if p.source isa RenderProgramSource
-        for data in (("vertex", GL_VERTEX_SHADER, p.source.src_vertex),
-                    ("fragment", GL_FRAGMENT_SHADER, p.source.src_fragment),
-                    ("geometry", GL_GEOMETRY_SHADER, p.source.src_geometry))
-            if exists(data[3])
-                result = compile_stage(data...)
-                if result isa String
-                    # Clean up the shaders/program, then return the error message.
-                    map(glDeleteShader, compiled_handles)
-                    glDeleteProgram(out_ptr)
-                    return result
-                else
-                    push!(compiled_handles, result)
-                end
+        for (name, type, src) in (("vertex", GL_VERTEX_SHADER, p.source.src_vertex),
+                                  ("fragment", GL_FRAGMENT_SHADER, p.source.src_fragment),
+                                  ("geometry", GL_GEOMETRY_SHADER, p.source.src_geometry))
+            if exists(src)
+                push!(stages, (name, start_compile_stage(type, src)))
             end
         end
     elseif p.source isa ComputeProgramSource
-        result = compile_stage("compute", GL_COMPUTE_SHADER, p.source.src)
-        if result isa String
-            # Clean up the shaders/program, then return the error message.
-            map(glDeleteShader, compiled_handles)
-            glDeleteProgram(out_ptr)
-            return result
-        else
-            push!(compiled_handles, result)
-        end
+        push!(stages, ("compute", start_compile_stage(GL_COMPUTE_SHADER, p.source.src)))
     else
         error("Unhandled case: ", typeof(p.source))
     end
 
-    # Link the shader program together.
-    for shad_ptr in compiled_handles
+    # Start linking the shader program together.
+    # If a stage failed to compile, linking will simply fail too;
+    #    the stage's own error message is reported when the job is finished.
+    for (_, shad_ptr) in stages
         glAttachShader(out_ptr, shad_ptr)
     end
-    glLinkProgram(out_ptr)
-    map(glDeleteShader, compiled_handles)
+    if link_eagerly
+        glLinkProgram(out_ptr)
+    end
+
+    return ProgramCompileJob(p, update_cache, nothing, nothing,
+                             out_ptr, stages, link_eagerly, false)
+end
+"
+Starts compiling the given program, trying the cache's binary first.
+When finished, a newly-compiled binary is written into the cache.
+Must be called on the GL thread.
+"
+function start_compile_program(p::ProgramCompiler, cache::ProgramBinaryCache
+                               ; link_eagerly::Bool = true)::ProgramCompileJob
+    loaded_binary = load_program_binary(cache, p)
+    if exists(loaded_binary)
+        p.cached_binary = loaded_binary
+    end
+
+    job = start_compile_program(p, true; link_eagerly=link_eagerly)
+    job.binary_cache = cache
+    job.loaded_binary = loaded_binary
+    return job
+end
+
+"
+Checks whether the job's program is done compiling, meaning `finish_compile_program()` won't block.
+If the driver can't compile in the background, this always returns `true`
+    (and finishing the job does the actual work).
+"
+function is_compile_done(job::ProgramCompileJob)::Bool
+    if job.is_finished || isempty(job.stages) || !job.is_linked ||
+       !get_context().device.supports_parallel_shader_compile
+        return true
+    end
+    return get_from_ogl(GLint, glGetProgramiv, job.handle, GL_COMPLETION_STATUS_KHR) == GL_TRUE
+end
+
+"
+Waits for the job to finish compiling, and cleans up after it.
+Returns the new program's handle, or a compile error message.
+"
+function finish_compile_program(job::ProgramCompileJob)::Union{Ptr_Program, String}
+    @bp_check(!job.is_finished, "This ProgramCompileJob was already finished")
+    job.is_finished = true
+    p = job.compiler
+    out_ptr = job.handle
+
+    # Check for compile errors.
+    stage_error::Optional{String} = nothing
+    for (name, shad_ptr) in job.stages
+        stage_error = get_stage_error(name, shad_ptr)
+        if exists(stage_error)
+            break
+        end
+    end
+    if isnothing(stage_error) && !job.is_linked
+        glLinkProgram(out_ptr)
+    end
+    delete_compile_stages(job)
+    if exists(stage_error)
+        glDeleteProgram(out_ptr)
+        return stage_error
+    end
 
     # Check for link errors.
     if get_from_ogl(GLint, glGetProgramiv, out_ptr, GL_LINK_STATUS) == GL_FALSE
@@ -290,35 +523,65 @@ function compile_program( p::ProgramCompiler,
         return string("Error linking shaders: ", String(msg_data[1:msg_len]))
     end
 
-    # We need to "detach" the shader objects
-    #    from the main program object, so that they can be cleaned up.
-    for handle in compiled_handles
-        glDetachShader(out_ptr, handle)
-    end
-
-    # Update the cached compiled program.
-    if update_cache
-        byte_size = get_from_ogl(GLint, glGetProgramiv, GL_PROGRAM_BINARY_LENGTH)
-        @bp_gl_assert(byte_size > 0,
-                      "Didn't return an error message earlier, yet compilation failed?")
-
-        # Allocate space in the cache to hold the program binary.
-        if exists(p.cached_binary)
-            resize!(p.cached_binary, byte_size)
-        else
-            p.cached_binary = PreCompiledProgram(zero(GLenum), Vector{UInt8}(undef, byte_size))
+    # Update the cached compiled program, unless it came from that binary in the first place.
+    if job.update_cache && !isempty(job.stages)
+        byte_size = get_from_ogl(GLint, glGetProgramiv, out_ptr, GL_PROGRAM_BINARY_LENGTH)
+        # Drivers are allowed to not support any binary formats, in which case there's nothing to cache.
+        if byte_size > 0
+            format = Ref{GLenum}()
+            data = Vector{UInt8}(undef, byte_size)
+            glGetProgramBinary(out_ptr, byte_size, C_NULL, format, Ref(data, 1))
+            p.cached_binary = PreCompiledProgram(format[], data)
         end
+    end
+    if exists(job.binary_cache) && exists(p.cached_binary) && (p.cached_binary !== job.loaded_binary)
+        save_program_binary(job.binary_cache, p)
+    end
 
-        glGetProgramBinary(program, byte_size,
-                           Ref(C_NULL),
-                           Ref(p.cached_binary.header),
-                           Ref(p.cached_binary.data, 1))
+    return out_ptr
+end
 
+"
+Abandons the job, cleaning up its OpenGL objects.
+Does nothing if the job was already finished.
+"
+function Base.close(job::ProgramCompileJob)
+    if !job.is_finished
+        job.is_finished = true
+        delete_compile_stages(job)
+        glDeleteProgram(job.handle)
     end
+end
 
-    return out_ptr
+# We need to "detach" the shader objects from the main program object,
+#    so that they're cleaned up when deleted.
+function delete_compile_stages(job::ProgramCompileJob)
+    for (_, shad_ptr) in job.stages
+        glDetachShader(job.handle, shad_ptr)
+        glDeleteShader(shad_ptr)
+    end
 end
 
+export start_compile_program, is_compile_done, finish_compile_program
+
+
+"
+Run the given compile job, blocking until it's finished.
+Returns the new program's handle, or a compile error message.
+Also optionally updates the compiler 'cached_binary' field to contain
+    the program's up-to-date binary blob.
+"
+compile_program(p::ProgramCompiler, update_cache::Bool = false)::Union{Ptr_Program, String} =
+    finish_compile_program(start_compile_program(p, update_cache; link_eagerly=false))
+"
+Runs the given compile job, trying the cache's binary first.
+If the binary is missing or fails to link, the program is compiled from source
+    and its new binary is written into the cache.
+Returns the new program's handle, or a compile error message.
+"
+compile_program(p::ProgramCompiler, cache::ProgramBinaryCache)::Union{Ptr_Program, String} =
+    finish_compile_program(start_compile_program(p, cache; link_eagerly=false))
+
 export ProgramCompiler, compile_program
 
 
@@ -339,9 +602,12 @@ end
 function Program(vert_shader::String, frag_shader::String
                  ;
                  geom_shader::Optional{String} = nothing,
-                 flexible_mode::Bool = true)
+                 flexible_mode::Bool = true,
+                 binary_cache::Optional{ProgramBinaryCache} = nothing)
     compiler = ProgramCompiler(vert_shader, frag_shader; src_geometry = geom_shader)
-    result = compile_program(compiler)
+    result = isnothing(binary_cache) ?
+                 compile_program(compiler) :
+                 compile_program(compiler, binary_cache)
     if result isa Ptr_Program
         return Program(result, flexible_mode)
     elseif result isa String
@@ -352,9 +618,12 @@ function Program(vert_shader::String, frag_shader::String
 end
 function Program(compute_shader::String
                  ;
-                 flexible_mode::Bool = true)
+                 flexible_mode::Bool = true,
+                 binary_cache::Optional{ProgramBinaryCache} = nothing)
     compiler = ProgramCompiler(compute_shader)
-    result = compile_program(compiler)
+    result = isnothing(binary_cache) ?
+                 compile_program(compiler) :
+                 compile_program(compiler, binary_cache)
     if result isa Ptr_Program
         return Program(result, flexible_mode; is_compute=true)
     elseif result isa String
@@ -363,6 +632,21 @@ function Program(compute_shader::String
         error("Unhandled case: ", typeof(result), "\n\t: ", result)
     end
 end
+"
+Finishes a background compile job (see `start_compile_program()`), blocking if it isn't done yet.
+Throws an error if compilation failed.
+"
+function Program(job::ProgramCompileJob; flexible_mode::Bool = true)
+    result = finish_compile_program(job)
+    if result isa Ptr_Program
+        return Program(result, flexible_mode;
+                       is_compute = (job.compiler.source isa ComputeProgramSource))
+    elseif result isa String
+        error(result)
+    else
+        error("Unhandled case: ", typeof(result), "\n\t: ", result)
+    end
+end
 function Program(handle::Ptr_Program, flexible_mode::Bool = false; is_compute::Bool = false)
     context = get_context()
     @bp_check(exists(context), "Creating a Program without a valid Context")
@@ -487,6 +771,12 @@ end
 function Base.close(p::Program)
     service_ViewDebugging_remove_program(p.handle)
     @bp_check(p.handle != Ptr_Program(), "Already closed this Program")
+    # Deactivate it first, so the Context doesn't remember a name the driver may reuse.
+    context = get_context()
+    if exists(context) && (context.active_program == p.handle)
+        glUseProgram(Ptr_Program())
+        setfield!(context, :active_program, Ptr_Program())
+    end
     glDeleteProgram(p.handle)
     setfield!(p, :handle, Ptr_Program())
 end
@@ -791,9 +1081,14 @@ function set_uniform_block(buf::Buffer, idx::Int;
         glBindBufferRange(GL_UNIFORM_BUFFER, idx - 1, handle,
                           min_inclusive(byte_range) - 1,
                           size(byte_range))
+        context.state_counters.n_block_binds_issued += 1
+    else
+        context.state_counters.n_block_binds_skipped += 1
     end
     return nothing
 end
+set_uniform_block(a::StreamingAllocation, idx::Int; context::Context = get_context()) =
+    set_uniform_block(a.buffer, idx; context=context, byte_range=a.byte_range)
 function set_uniform_block(program::Program, name::AbstractString, idx::Int)
     if !haskey(program.uniform_blocks, name)
         if program.flexible_mode
@@ -812,6 +1107,9 @@ function set_uniform_block(idx::Int; context::Context = get_context())
     if context.active_ubos[idx] != cleared_binding
         context.active_ubos[idx] = cleared_binding
         glBindBufferBase(GL_UNIFORM_BUFFER, idx - 1, Ptr_Buffer())
+        context.state_counters.n_block_binds_issued += 1
+    else
+        context.state_counters.n_block_binds_skipped += 1
     end
     return nothing
 end
@@ -830,9 +1128,14 @@ function set_storage_block(buf::Buffer, idx::Int;
         glBindBufferRange(GL_SHADER_STORAGE_BUFFER, idx - 1, handle,
                           min_inclusive(byte_range) - 1,
                           size(byte_range))
+        context.state_counters.n_block_binds_issued += 1
+    else
+        context.state_counters.n_block_binds_skipped += 1
     end
     return nothing
 end
+set_storage_block(a::StreamingAllocation, idx::Int; context::Context = get_context()) =
+    set_storage_block(a.buffer, idx; context=context, byte_range=a.byte_range)
 function set_storage_block(program::Program, name::AbstractString, idx::Int)
     if !haskey(program.storage_blocks, name)
         if program.flexible_mode
@@ -851,6 +1154,9 @@ function set_storage_block(idx::Int; context::Context = get_context())
     if context.active_ssbos[idx] != cleared_binding
         context.active_ssbos[idx] = cleared_binding
         glBindBufferBase(GL_SHADER_STORAGE_BUFFER, idx - 1, Ptr_Buffer())
+        context.state_counters.n_block_binds_issued += 1
+    else
+        context.state_counters.n_block_binds_skipped += 1
     end
     return nothing
 end
@@ -0,0 +1,170 @@
+# Reading data back from the GPU normally stalls until the GPU has caught up
+#    with every command that was issued before it.
+# The readbacks below instead copy into a persistently-mapped staging buffer,
+#    which the CPU can read a frame or two later once a fence says the copy is done.
+
+
+"
+Reads part of a Texture back to the CPU without stalling.
+
+1. Create it once for a given texture subset and pixel type,
+     e.x. `TexReadback(tex, vRGBAu8)`.
+2. Call `start_tex_readback!(readback)` after issuing the commands that write to the texture.
+3. Later on (e.x. next frame), check `is_readback_ready()` or block with `wait_for_readback()`.
+4. Read the pixels with `get_readback_data()`, which points directly into the staging memory.
+     The data is only valid until the readback is started again or closed.
+"
+mutable struct TexReadback{T<:PixelIOValue, N} <: AbstractResource
+    tex::Texture
+    subset::TexSubset{N}
+    staging::Buffer
+    # The staging memory, shaped like the texture subset.
+    pixels::Array{T, N}
+
+    bgr_ordering::Bool
+    single_component::E_PixelIOChannels
+
+    # Signaled once the GPU has finished the last started copy.
+    fence::Optional{GLFence}
+
+    function TexReadback( tex::Texture,
+                          ::Type{T},
+                          subset::TexSubset{N} = default_tex_subset(tex)
+                          ;
+                          bgr_ordering::Bool = false,
+                          single_component::E_PixelIOChannels = PixelIOChannels.red
+                        ) where {T<:PixelIOValue, N}
+        (pixel_range, _) = process_tex_subset(tex, subset)
+        pixel_counts = ntuple(i -> Int(size(pixel_range)[i]), Val(N))
+
+        staging = Buffer(prod(pixel_counts) * sizeof(T), false, true;
+                         map_mode = BufferMapModes.coherent,
+                         map_readable = true)
+        pixels = unsafe_wrap(Array, Ptr{T}(staging.mapped_ptr), pixel_counts; own=false)
+
+        return new{T, N}(tex, subset, staging, pixels,
+                         bgr_ordering, single_component,
+                         nothing)
+    end
+end
+
+"
+Reads part of a Buffer back to the CPU without stalling.
+Use it like a `TexReadback`, but start it with `start_buffer_readback!()`.
+"
+mutable struct BufferReadback <: AbstractResource
+    staging::Buffer
+    # The number of bytes copied by the last started readback.
+    byte_size::Int
+    fence::Optional{GLFence}
+
+    BufferReadback(max_byte_size::Integer) = new(
+        Buffer(max_byte_size, true, true;
+               map_mode = BufferMapModes.coherent,
+               map_readable = true),
+        0, nothing
+    )
+end
+
+const AnyReadback = Union{TexReadback, BufferReadback}
+
+get_ogl_handle(r::AnyReadback) = get_ogl_handle(r.staging)
+is_destroyed(r::AnyReadback) = is_destroyed(r.staging)
+
+function Base.close(r::AnyReadback)
+    if exists(r.fence)
+        close(r.fence)
+        setfield!(r, :fence, nothing)
+    end
+    close(r.staging)
+end
+
+export TexReadback, BufferReadback
+
+
+"
+Starts copying the texture's pixels into the readback's staging memory.
+Must be called on the GL thread.
+"
+function start_tex_readback!(r::TexReadback)
+    @bp_check(!is_destroyed(r.tex), "Texture was destroyed before its readback started")
+    replace_readback_fence(r) do
+        if is_color(r.tex.format)
+            get_tex_color(r.tex, r.pixels, r.subset;
+                          bgr_ordering = r.bgr_ordering,
+                          single_component = r.single_component,
+                          pixel_buffer = r.staging)
+        else
+            get_tex_pixels(r.tex, r.pixels, r.subset;
+                           pixel_buffer = r.staging)
+        end
+    end
+end
+
+"
+Starts copying part of a buffer into the readback's staging memory.
+Must be called on the GL thread.
+"
+function start_buffer_readback!(r::BufferReadback, src::Buffer
+                                ;
+                                src_byte_offset::Integer = 0,
+                                byte_size::Integer = min(src.byte_size - src_byte_offset,
+                                                         r.staging.byte_size)
+                               )
+    @bp_check(byte_size <= r.staging.byte_size,
+              "Trying to read back ", byte_size, " bytes, but the staging buffer only has ",
+                r.staging.byte_size)
+    replace_readback_fence(r) do
+        copy_buffer(src, r.staging;
+                    src_byte_offset = src_byte_offset,
+                    byte_size = byte_size)
+        setfield!(r, :byte_size, Int(byte_size))
+    end
+end
+
+export start_tex_readback!, start_buffer_readback!
+
+
+"
+Checks whether the GPU has finished the last started readback.
+Returns `false` if the readback was never started.
+"
+is_readback_ready(r::AnyReadback)::Bool = exists(r.fence) && is_fence_done(r.fence)
+
+"
+Waits until the GPU has finished the last started readback, or the timeout has elapsed.
+Returns whether the data is ready.
+"
+function wait_for_readback(r::AnyReadback, timeout_ns::Integer = typemax(UInt64))::Bool
+    @bp_check(exists(r.fence), "Readback was never started")
+    return wait_for_fence(r.fence, timeout_ns)
+end
+
+"
+Gets the data copied by the last finished readback,
+    pointing directly into the staging memory (no copy is made).
+It's only valid until the readback is started again or closed.
+
+Texture readbacks return an array shaped like the texture subset.
+Buffer readbacks return a vector of the given element type.
+"
+function get_readback_data(r::TexReadback)
+    @bp_check(is_readback_ready(r), "Readback isn't finished yet")
+    return r.pixels
+end
+function get_readback_data(r::BufferReadback, ::Type{T} = UInt8)::Vector{T} where {T}
+    @bp_check(is_readback_ready(r), "Readback isn't finished yet")
+    return get_mapped_array(r.staging, T; n_elements = r.byte_size ÷ sizeof(T))
+end
+
+export is_readback_ready, wait_for_readback, get_readback_data
+
+
+function replace_readback_fence(start_copy::Function, r::AnyReadback)
+    if exists(r.fence)
+        close(r.fence)
+    end
+    start_copy()
+    setfield!(r, :fence, GLFence())
+    return nothing
+end
@@ -35,17 +35,22 @@ export gl_flush_texture_writes_in_place
     buffer_download_or_upload = GL_BUFFER_UPDATE_BARRIER_BIT,
     buffer_uniforms = GL_UNIFORM_BARRIER_BIT,
     buffer_storage = GL_SHADER_STORAGE_BARRIER_BIT,
+    # Makes GPU writes visible through a persistently-mapped buffer (see `BufferMapModes`).
+    buffer_map_usage = GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT,
 
     texture_samples = GL_TEXTURE_FETCH_BARRIER_BIT,
     texture_simple_views = GL_SHADER_IMAGE_ACCESS_BARRIER_BIT,
     texture_upload_or_download = GL_TEXTURE_UPDATE_BARRIER_BIT,
+    # Makes shader writes to a Buffer visible to texture uploads/downloads that use it
+    #    as a pixel buffer (see `TexUpload`).
+    texture_async_download_or_upload = GL_PIXEL_BUFFER_BARRIER_BIT,
 
     target_attachments = GL_FRAMEBUFFER_BARRIER_BIT,
 
-    # Not yet relevant to B+, but will be one day:
+    # Makes shader writes visible to indirect draw commands (see `render_mesh_indirect()`).
     indirect_draw = GL_COMMAND_BARRIER_BIT,
-    texture_async_download_or_upload = GL_PIXEL_BUFFER_BARRIER_BIT,
-    buffer_map_usage = GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT,
+
+    # Not yet relevant to B+, but will be one day:
     buffer_atomics = GL_ATOMIC_COUNTER_BARRIER_BIT,
 
     # This bit generates an OpenGL error if used. Already logged as a B+ ticket.
@@ -92,4 +97,55 @@ function gl_catch_up_renders_before(actions::E_MemoryActions)
 end
 
 export gl_catch_up_before, gl_catch_up_renders_before,
-       E_MemoryActions, MemoryActions
\ No newline at end of file
+       E_MemoryActions, MemoryActions
+
+
+"
+A marker in OpenGL's command stream, which lets the CPU find out
+    when the GPU has finished executing every command issued before it.
+Useful for knowing when the GPU is done reading memory you want to overwrite,
+    e.x. a region of a persistently-mapped Buffer.
+
+Create one right after issuing the commands you care about,
+    then use `is_fence_done()` or `wait_for_fence()`, and finally `close()` it.
+"
+mutable struct GLFence
+    handle::GLsync
+    GLFence() = new(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0))
+end
+
+function Base.close(f::GLFence)
+    if f.handle != C_NULL
+        glDeleteSync(f.handle)
+        f.handle = C_NULL
+    end
+end
+
+"Checks whether the GPU has passed the fence yet, without waiting"
+is_fence_done(f::GLFence)::Bool = wait_for_fence(f, 0)
+
+"
+Waits until the GPU has passed the fence, or the timeout has elapsed.
+Returns whether the fence was passed.
+"
+function wait_for_fence(f::GLFence, timeout_ns::Integer = typemax(UInt64))::Bool
+    @bp_check(f.handle != C_NULL, "Fence has already been closed")
+    # The first wait flushes the command queue, otherwise the fence might never be reached.
+    flags::GLbitfield = GL_SYNC_FLUSH_COMMANDS_BIT
+    while true
+        result = glClientWaitSync(f.handle, flags, UInt64(timeout_ns))
+        if (result == GL_ALREADY_SIGNALED) || (result == GL_CONDITION_SATISFIED)
+            return true
+        elseif result == GL_TIMEOUT_EXPIRED
+            # Keep waiting if the timeout is effectively infinite.
+            if timeout_ns < typemax(UInt64)
+                return false
+            end
+        else
+            error("Failed to wait on a GL fence")
+        end
+        flags = 0
+    end
+end
+
+export GLFence, is_fence_done, wait_for_fence
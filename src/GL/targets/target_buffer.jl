@@ -27,11 +27,15 @@ function TargetBuffer(size::Vec2{<:Integer}, format::TexFormat)
 
     handle = Ptr_TargetBuffer(get_from_ogl(gl_type(Ptr_TargetBuffer), glCreateRenderbuffers, 1))
     glNamedRenderbufferStorage(handle, gl_format, size...)
+    track_memory!(:gl_target_buffers, get_byte_size(format, size))
 
     return TargetBuffer(handle, size, format)
 end
 
 function Base.close(b::TargetBuffer)
+    if b.handle != Ptr_TargetBuffer()
+        untrack_memory!(:gl_target_buffers, get_byte_size(b.format, b.size))
+    end
     glDeleteRenderbuffers(1, Ref(gl_type(b.handle)))
     setfield!(b, :handle, Ptr_TargetBuffer())
 end
@@ -124,8 +124,8 @@ end
 export get_native_ogl_enum
 
 
-# Default behavior for texture byte size: pixel bit size * number of pixels * 8.
-get_byte_size(format, size::VecI) = get_pixel_bit_size(format) * 8 * reduce(*, map(Int64, size))
+# Default behavior for texture byte size: pixel bit size * number of pixels / 8.
+get_byte_size(format, size::VecI) = (get_pixel_bit_size(format) * reduce(*, map(Int64, size))) ÷ 8
 
 
 ###########################
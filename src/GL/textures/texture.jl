@@ -40,6 +40,9 @@ function Base.close(t::Texture)
         view.handle = Ptr_View()
     end
 
+    if t.handle != Ptr_Texture()
+        untrack_memory!(:gl_textures, get_gpu_byte_size(t))
+    end
     glDeleteTextures(1, Ref(gl_type(t.handle)))
     setfield!(t, :handle, Ptr_Texture())
 end
@@ -350,6 +353,7 @@ function generate_texture( type::E_TexTypes,
     else
         error("Unhandled case: ", tex.type)
     end
+    track_memory!(:gl_textures, get_gpu_byte_size(tex))
 
     # Upload the initial data, if given.
     if exists(initial_data)
@@ -386,7 +390,10 @@ function texture_op_impl( tex::Texture,
                           #    matches the size of the texture subset.
                           known_subset_data_size::Optional{VecT{<:Integer}} = nothing
                           ;
-                          get_buf_pixel_byte_size::Int = -1  # Only for Get ops
+                          get_buf_pixel_byte_size::Int = -1,  # Only for Get ops
+                          # If the pixel array lives in this mapped Buffer's memory,
+                          #    OpenGL can do the copy asynchronously.
+                          pixel_buffer::Optional{Buffer} = nothing  # Only for Get/Set ops
                         )
     (subset_pixels_3D::Box3Du, mip::UInt) = process_tex_subset(tex, subset)
 
@@ -398,6 +405,26 @@ function texture_op_impl( tex::Texture,
                     ", but the texture (or subset/mip) you are working with is larger: ", subset_pixels_3D)
     end
 
+    # If the pixels are in a mapped Buffer, bind it as a "pixel buffer object",
+    #    and tell OpenGL the byte offset into it instead of a CPU pointer.
+    local pixel_data::Union{Ref, Ptr{Cvoid}} = value
+    pixel_buffer_target::GLenum = (mode isa Val{:Get}) ? GL_PIXEL_PACK_BUFFER : GL_PIXEL_UNPACK_BUFFER
+    if exists(pixel_buffer)
+        @bp_check(!(mode isa Val{:Clear}), "Clearing a texture doesn't use a pixel buffer")
+        @bp_check(pixel_buffer.mapped_ptr != C_NULL,
+                  "Pixel buffer must be mapped, and the pixel array must be in its mapped memory")
+        byte_offset = GC.@preserve value (Base.unsafe_convert(Ptr{Cvoid}, value) - pixel_buffer.mapped_ptr)
+        # OpenGL touches every pixel of the subset, so all of them must be inside the buffer.
+        pixel_byte_size = (mode isa Val{:Get}) ? get_buf_pixel_byte_size : sizeof(eltype(value))
+        n_bytes = prod(size(subset_pixels_3D)) * pixel_byte_size
+        @bp_check((byte_offset >= 0) && (byte_offset + n_bytes <= pixel_buffer.byte_size),
+                  "Pixel array isn't inside the pixel buffer's mapped memory: ",
+                    n_bytes, " bytes at offset ", byte_offset,
+                    " in a buffer of ", pixel_buffer.byte_size, " bytes")
+        pixel_data = Ptr{Cvoid}(byte_offset)
+        glBindBuffer(pixel_buffer_target, get_ogl_handle(pixel_buffer))
+    end
+
     # Perform the requested operation.
     if mode isa Val{:Set}
         @bp_gl_assert(get_buf_pixel_byte_size == -1,
@@ -407,19 +434,19 @@ function texture_op_impl( tex::Texture,
                                 min_inclusive(subset_pixels_3D).x - 1,
                                 size(subset_pixels_3D).x,
                                 components, component_type,
-                                value)
+                                pixel_data)
         elseif tex.type == TexTypes.twoD
             glTextureSubImage2D(tex.handle, mip - 1,
                                 (min_inclusive(subset_pixels_3D).xy - 1)...,
                                 size(subset_pixels_3D).xy...,
                                 components, component_type,
-                                value)
+                                pixel_data)
         elseif (tex.type == TexTypes.threeD) || (tex.type == TexTypes.cube_map)
             glTextureSubImage3D(tex.handle, mip - 1,
                                 (min_inclusive(subset_pixels_3D) - 1)...,
                                 size(subset_pixels_3D)...,
                                 components, component_type,
-                                value)
+                                pixel_data)
         else
             error("Unhandled case: ", tex.type)
         end
@@ -433,7 +460,7 @@ function texture_op_impl( tex::Texture,
                              size(subset_pixels_3D)...,
                              components, component_type,
                              prod(size(subset_pixels_3D)) * get_buf_pixel_byte_size,
-                             value)
+                             pixel_data)
     elseif mode isa Val{:Clear}
         @bp_gl_assert(get_buf_pixel_byte_size == -1,
                       "Internal field 'get_buf_pixel_byte_size' shouldn't be passed for a Clear op")
@@ -444,6 +471,10 @@ function texture_op_impl( tex::Texture,
                            value)
     end
 
+    if exists(pixel_buffer)
+        glBindBuffer(pixel_buffer_target, Ptr_Buffer())
+    end
+
     if recompute_mips
         glGenerateTextureMipmap(tex.handle)
     end
@@ -517,10 +548,11 @@ end
 
 "Gets the byte size of a specific texture mip level"
 function get_mip_byte_size(t::Texture, level::Integer)
-    if t.type == TexTypes.cube
-        return get_byte_size(t.format, t.size.xy * Vec(6, 1))
+    mip_size = get_mip_size(t.size, level)
+    if t.type == TexTypes.cube_map
+        return get_byte_size(t.format, mip_size.xy * Vec(6, 1))
     else
-        return get_byte_size(t.format, t.size)
+        return get_byte_size(t.format, mip_size)
     end
 end
 "Gets the total byte-size of this texture's pixels, including all mips"
@@ -691,6 +723,7 @@ end
 "
 Sets a texture's pixels, figuring out dynamically whether they're color, depth, etc.
 For specific overloads based on texture format, see `set_tex_color()`, `set_tex_depth()`, etc respectively.
+To upload without stalling on the driver's copy, see `TexUpload`.
 
 The dimensionality of the input array and `subset` parameter
     must match the dimensionality of the texture.
@@ -723,7 +756,8 @@ function set_tex_color( t::Texture,
                         ;
                         bgr_ordering::Bool = false,
                         single_component::E_PixelIOChannels = PixelIOChannels.red,
-                        recompute_mips::Bool = true
+                        recompute_mips::Bool = true,
+                        pixel_buffer::Optional{Buffer} = nothing
                       ) where {TBuf <: PixelBuffer}
     T = get_component_type(TBuf)
     N = get_component_count(TBuf)
@@ -746,6 +780,8 @@ function set_tex_color( t::Texture,
         Ref(pixels, 1),
         recompute_mips,
         Val(:Set), vsize(pixels)
+        ;
+        pixel_buffer = pixel_buffer
     )
 end
 "
@@ -758,7 +794,8 @@ function set_tex_depth( t::Texture,
                         pixels::PixelBuffer{T},
                         subset::TexSubset = default_tex_subset(t)
                         ;
-                        recompute_mips::Bool = true
+                        recompute_mips::Bool = true,
+                        pixel_buffer::Optional{Buffer} = nothing
                       ) where {T<:Union{Number, Vec{1, <:Number}}}
     @bp_check(is_depth_only(t.format),
               "Can't set depth values in a texture of format ", t.format)
@@ -771,6 +808,8 @@ function set_tex_depth( t::Texture,
         recompute_mips,
         Val(:Set),
         vsize(pixels)
+        ;
+        pixel_buffer = pixel_buffer
     )
 end
 "
@@ -783,7 +822,8 @@ function set_tex_stencil( t::Texture,
                           pixels::PixelBuffer{<:Union{UInt8, Vec{1, UInt8}}},
                           subset::TexSubset = default_tex_subset(t)
                           ;
-                          recompute_mips::Bool = true
+                          recompute_mips::Bool = true,
+                          pixel_buffer::Optional{Buffer} = nothing
                         )
     @bp_check(is_stencil_only(t.format),
               "Can't set stencil values in a texture of format ", t.format)
@@ -796,6 +836,8 @@ function set_tex_stencil( t::Texture,
         recompute_mips,
         Val(:Set),
         vsize(pixels)
+        ;
+        pixel_buffer = pixel_buffer
     )
 end
 "
@@ -808,7 +850,8 @@ function set_tex_depthstencil( t::Texture,
                                pixels::PixelBuffer{T},
                                subset::TexSubset = default_tex_subset(t)
                                ;
-                               recompute_mips::Bool = true
+                               recompute_mips::Bool = true,
+                               pixel_buffer::Optional{Buffer} = nothing
                              ) where {T <: Union{Depth24uStencil8u, Depth32fStencil8u}}
     local component_type::GLenum
     if T == Depth24uStencil8u
@@ -832,12 +875,15 @@ function set_tex_depthstencil( t::Texture,
         recompute_mips,
         Val(:Set),
         vsize(pixels)
+        ;
+        pixel_buffer = pixel_buffer
     )
 end
 
 "
 Gets a texture's pixels, figuring out dynamically whether they're color, depth, etc.
 For specific overloads based on texture format, see `get_tex_color()`, `get_tex_depth()`, etc, respectively.
+To read back without stalling until the GPU catches up, see `TexReadback`.
 
 The dimensionality of the array and `subset` parameter
     must match the dimensionality of the texture.
@@ -869,7 +915,8 @@ function get_tex_color( t::Texture,
                         subset::TexSubset = default_tex_subset(t)
                         ;
                         bgr_ordering::Bool = false,
-                        single_component::E_PixelIOChannels = PixelIOChannels.red
+                        single_component::E_PixelIOChannels = PixelIOChannels.red,
+                        pixel_buffer::Optional{Buffer} = nothing
                       ) where {TBuf <: PixelBuffer}
     T = get_component_type(TBuf)
     N = get_component_count(TBuf)
@@ -894,7 +941,8 @@ function get_tex_color( t::Texture,
         Val(:Get),
         vsize(out_pixels),
         ;
-        get_buf_pixel_byte_size = N * sizeof(T)
+        get_buf_pixel_byte_size = N * sizeof(T),
+        pixel_buffer = pixel_buffer
     )
 end
 "
@@ -906,6 +954,8 @@ Cubemaps textures are 3D, where Z spans the 6 faces.
 function get_tex_depth( t::Texture,
                         out_pixels::PixelBuffer{T},
                         subset::TexSubset = default_tex_subset(t)
+                        ;
+                        pixel_buffer::Optional{Buffer} = nothing
                       ) where {T <: Union{Number, Vec{1, <:Number}}}
     @bp_check(is_depth_only(t.format), "Can't get depth data from a texture of format ", t.format)
     texture_op_impl(
@@ -918,7 +968,8 @@ function get_tex_depth( t::Texture,
         Val(:Get),
         vsize(out_pixels),
         ;
-        get_buf_pixel_byte_size = sizeof(T)
+        get_buf_pixel_byte_size = sizeof(T),
+        pixel_buffer = pixel_buffer
     )
 end
 "
@@ -930,6 +981,8 @@ Cubemaps textures are 3D, where Z spans the 6 faces.
 function get_tex_stencil( t::Texture,
                           out_pixels::PixelBuffer{<:Union{UInt8, Vec{1, UInt8}}},
                           subset::TexSubset = default_tex_subset(t)
+                          ;
+                          pixel_buffer::Optional{Buffer} = nothing
                         )
     @bp_check(is_stencil_only(t.format), "Can't get stencil data from a texture of format ", t.format)
     texture_op_impl(
@@ -942,7 +995,8 @@ function get_tex_stencil( t::Texture,
         Val(:Get),
         vsize(out_pixels),
         ;
-        get_buf_pixel_byte_size = sizeof(UInt8)
+        get_buf_pixel_byte_size = sizeof(UInt8),
+        pixel_buffer = pixel_buffer
     )
 end
 "
@@ -954,6 +1008,8 @@ Cubemaps textures are 3D, where Z spans the 6 faces.
 function get_tex_depthstencil( t::Texture,
                                out_pixels::PixelBuffer{T},
                                subset::TexSubset = default_tex_subset(t)
+                               ;
+                               pixel_buffer::Optional{Buffer} = nothing
                              ) where {T <: Union{Depth24uStencil8u, Depth32fStencil8u}}
     local component_type::GLenum
     if T == Depth24uStencil8u
@@ -977,7 +1033,8 @@ function get_tex_depthstencil( t::Texture,
         Val(:Get),
         vsize(out_pixels)
         ;
-        get_buf_pixel_byte_size = sizeof(T)
+        get_buf_pixel_byte_size = sizeof(T),
+        pixel_buffer = pixel_buffer
     )
 end
 #TODO: Texture getters can also return an array rather than writing into an existing one.
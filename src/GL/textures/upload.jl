@@ -0,0 +1,111 @@
+"
+Uploads pixels into part of a Texture without stalling,
+    by staging them in a persistently-mapped \"pixel unpack buffer\".
+
+1. Create it once for a given texture subset and pixel type,
+     e.x. `TexUpload(tex, vRGBAu8)`.
+2. Fill `upload.pixels`. This is plain memory, so it can be done from any thread
+     (for example, decoding an image file with `Threads.@spawn`).
+3. On the GL thread, call `start_tex_upload!(upload)`.
+     OpenGL copies the pixels from the staging buffer in the background.
+4. Before refilling `upload.pixels`, make sure the copy is finished with
+     `is_tex_upload_done()` or `wait_for_tex_upload()`.
+     The upload can then be started again, which makes it useful for streaming.
+"
+mutable struct TexUpload{T<:PixelIOValue, N} <: AbstractResource
+    tex::Texture
+    subset::TexSubset{N}
+    staging::Buffer
+    # The staging memory, shaped like the texture subset.
+    # Only valid until this upload is closed.
+    pixels::Array{T, N}
+
+    bgr_ordering::Bool
+    single_component::E_PixelIOChannels
+    recompute_mips::Bool
+
+    # Signaled once the GPU has finished the last started copy.
+    fence::Optional{GLFence}
+
+    function TexUpload( tex::Texture,
+                        ::Type{T},
+                        subset::TexSubset{N} = default_tex_subset(tex)
+                        ;
+                        bgr_ordering::Bool = false,
+                        single_component::E_PixelIOChannels = PixelIOChannels.red,
+                        recompute_mips::Bool = true
+                      ) where {T<:PixelIOValue, N}
+        (pixel_range, _) = process_tex_subset(tex, subset)
+        pixel_counts = ntuple(i -> Int(size(pixel_range)[i]), Val(N))
+
+        # The staging memory is written once by the CPU and read once by the GPU,
+        #    so it's recommended to live on the CPU side.
+        staging = Buffer(prod(pixel_counts) * sizeof(T), false, true;
+                         map_mode = BufferMapModes.coherent)
+        pixels = unsafe_wrap(Array, Ptr{T}(staging.mapped_ptr), pixel_counts; own=false)
+
+        return new{T, N}(tex, subset, staging, pixels,
+                         bgr_ordering, single_component, recompute_mips,
+                         nothing)
+    end
+end
+
+get_ogl_handle(u::TexUpload) = get_ogl_handle(u.staging)
+is_destroyed(u::TexUpload) = is_destroyed(u.staging)
+
+function Base.close(u::TexUpload)
+    if exists(u.fence)
+        close(u.fence)
+        setfield!(u, :fence, nothing)
+    end
+    close(u.staging)
+end
+
+export TexUpload
+
+
+"
+Starts copying the upload's pixels into its texture.
+Must be called on the GL thread, after `upload.pixels` has been filled.
+"
+function start_tex_upload!(u::TexUpload)
+    @bp_check(!is_destroyed(u.tex), "Texture was destroyed before its upload started")
+    if exists(u.fence)
+        @bp_check(is_fence_done(u.fence),
+                  "Started an upload again before the previous one finished; ",
+                    "this means the pixels were overwritten while the GPU was still reading them")
+        close(u.fence)
+    end
+
+    if is_color(u.tex.format)
+        set_tex_color(u.tex, u.pixels, u.subset;
+                      bgr_ordering = u.bgr_ordering,
+                      single_component = u.single_component,
+                      recompute_mips = u.recompute_mips,
+                      pixel_buffer = u.staging)
+    else
+        set_tex_pixels(u.tex, u.pixels, u.subset;
+                       recompute_mips = u.recompute_mips,
+                       pixel_buffer = u.staging)
+    end
+    setfield!(u, :fence, GLFence())
+
+    return nothing
+end
+
+"
+Checks whether the GPU has finished copying the pixels into the texture,
+    meaning `upload.pixels` can safely be refilled.
+Returns `true` if the upload was never started.
+"
+is_tex_upload_done(u::TexUpload)::Bool = isnothing(u.fence) || is_fence_done(u.fence)
+
+"
+Waits until the GPU has finished copying the pixels into the texture,
+    or the timeout has elapsed.
+Returns whether the copy is finished.
+"
+wait_for_tex_upload(u::TexUpload, timeout_ns::Integer = typemax(UInt64))::Bool =
+    isnothing(u.fence) || wait_for_fence(u.fence, timeout_ns)
+
+export start_tex_upload!, is_tex_upload_done, wait_for_tex_upload
@@ -1,8 +1,10 @@
 module Helpers
 
-using Setfield, Dates
+using Setfield, Dates, CRC32c
+import FileWatching
 
 using GLFW, DataStructures
+import CImGui
 
 using ..Utilities, ..Math, ..GL, ..Input, ..GUI
 
@@ -13,6 +15,9 @@ using ..Utilities, ..Math, ..GL, ..Input, ..GUI
 
 include("cam3D.jl")
 include("basic_graphics_service.jl")
+include("frame_pipeline.jl")
+include("frame_telemetry.jl")
+include("input_recording.jl")
 include("game_loop.jl")
 include("file_cacher.jl")
 
@@ -31,6 +31,94 @@ end
 export Cam3D, cam_rightward, cam_basis, cam_view_mat, cam_projection_mat
 
 
+###################
+##    Culling    ##
+###################
+
+"
+Data derived from a `Cam3D` which is needed for rendering and culling.
+Compute it once whenever the camera changes, rather than re-deriving it for every test.
+"
+struct Cam3D_Cache{F<:AbstractFloat}
+    view_mat::Mat{4, 4, F}
+    projection_mat::Mat{4, 4, F}
+    view_projection_mat::Mat{4, 4, F}
+    inv_view_projection_mat::Mat{4, 4, F}
+
+    # The world-space frustum. Test shapes against it with `collides()` or `collides_each!()`.
+    frustum::Frustum{F}
+    # The world-space corners of the frustum, ordered from the NDC cube's min corner to its max corner.
+    frustum_corners::NTuple{8, Vec3{F}}
+end
+function Cam3D_Cache(cam::Cam3D{F})::Cam3D_Cache{F} where {F}
+    view = cam_view_mat(cam)
+    projection = cam_projection_mat(cam)
+    view_projection = m_combine(view, projection)
+    inv_view_projection = m_invert(view_projection)
+    return Cam3D_Cache{F}(view, projection, view_projection, inv_view_projection,
+                          Frustum(view_projection), frustum_corners(inv_view_projection))
+end
+
+"
+Splits the camera's clip range into `n` consecutive ranges, for cascaded shadow maps.
+`log_weight` blends between evenly-spaced splits (0) and logarithmic splits (1);
+    logarithmic splits give nearby cascades more resolution.
+"
+function cam_cascade_ranges(cam::Cam3D{F}, n::Int; log_weight::Real = 0.5)::Vector{Interval{F}} where {F}
+    @bp_check(n > 0, "Need at least one cascade, got ", n)
+    near = min_inclusive(cam.clip_range)
+    far = max_exclusive(cam.clip_range)
+    split_at(i::Int)::F = if i == 0
+                              near
+                          elseif i == n
+                              far
+                          else
+                              t = convert(F, i / n)
+                              lerp(lerp(near, far, t), near * ((far / near) ^ t),
+                                   convert(F, log_weight))
+                          end
+    return [ Interval{F}(min=split_at(i - 1), max=split_at(i)) for i in 1:n ]
+end
+"
+Computes the frustum data for each of `n` cascades of the camera's clip range,
+    for fitting cascaded shadow maps.
+See `cam_cascade_ranges()` for more info.
+"
+cam_cascades(cam::Cam3D{F}, n::Int; kw...) where {F} = [
+    Cam3D_Cache(@set cam.clip_range = range)
+      for range in cam_cascade_ranges(cam, n; kw...)
+]
+
+"
+Projects a world-space box onto the screen, returning its bounds in NDC space (-1 to +1).
+Useful for picking levels of detail based on screen size.
+If part of the box is behind the camera, its projection is unbounded,
+    so the whole screen is returned.
+"
+function cam_screen_bounds(cache::Cam3D_Cache{F}, b::Box{3, F})::Box2D{F} where {F}
+    screen_min = Vec(typemax(F), typemax(F))
+    screen_max = Vec(typemin(F), typemin(F))
+    b_min = min_inclusive(b)
+    b_max = max_exclusive(b)
+    for corner in ((x, y, z) for z in (b_min.z, b_max.z) for y in (b_min.y, b_max.y) for x in (b_min.x, b_max.x))
+        clip_pos = cache.view_projection_mat * Vec{4, F}(corner..., one(F))
+        if clip_pos.w <= 0
+            return Box2D{F}(min=Vec(-one(F), -one(F)), size=Vec(F(2), F(2)))
+        end
+        ndc_pos = clip_pos.xy / clip_pos.w
+        screen_min = min(screen_min, ndc_pos)
+        screen_max = max(screen_max, ndc_pos)
+    end
+
+    # Clamp to the screen.
+    screen_min = clamp(screen_min, -one(F), one(F))
+    screen_max = clamp(screen_max, -one(F), one(F))
+    return Box2D{F}(min=screen_min, size=max(zero(F), screen_max - screen_min))
+end
+
+export Cam3D_Cache, cam_cascade_ranges, cam_cascades, cam_screen_bounds
+
+
 #######################
 ##     Settings      ##
 #######################
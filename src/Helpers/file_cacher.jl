@@ -41,6 +41,12 @@ mutable struct CachedData{TCached}
 
     last_check_time::DateTime
     disk_check_interval::Millisecond
+
+    # The size reported to the memory tracker, if it's enabled.
+    tracked_byte_size::Int
+    # The size counted against the cacher's byte budget, if it has one.
+    byte_size::Int
+    last_access::UInt64
 end
 
 function check_disk_modifications!(cd::CachedData)::Bool
@@ -54,6 +60,258 @@ function check_disk_modifications!(cd::CachedData)::Bool
 end
 
 
+##   FileCacherWatcher -- OS notifications of file changes   ##
+
+"How many file-change events can pile up between calls to `check_disk_modifications!()`."
+const FILE_WATCH_QUEUE_CAPACITY = 1024
+"How often each folder-watching Task wakes up to see if it should stop."
+const FILE_WATCH_TIMEOUT_SECONDS = 1.0
+"How long a folder-watching Task waits before retrying after an error, doubling each time up to a max."
+const FILE_WATCH_RETRY_MIN_SECONDS = 0.5
+const FILE_WATCH_RETRY_MAX_SECONDS = 30.0
+
+"
+Watches the folders containing a FileCacher's files, using OS notifications (e.x. inotify on Linux).
+Each folder gets its own background Task, which pushes the paths of changed files into a queue.
+
+FileWatching keeps its folder watches in an unsynchronized global table,
+    so the Tasks are started with `@async`, on the thread that uses the FileCacher,
+    rather than on arbitrary threads.
+Changes to the reference counts below are also behind a lock.
+"
+mutable struct FileCacherWatcher
+    events::MpmcQueue{String}
+    # Set if some events couldn't be recorded (e.x. the queue filled up),
+    #    meaning every file needs to be checked.
+    @atomic missed_events::Bool
+    @atomic is_running::Bool
+
+    folders::Dict{String, Task} # Only touched by the thread using the FileCacher
+end
+FileCacherWatcher() = FileCacherWatcher(MpmcQueue{String}(FILE_WATCH_QUEUE_CAPACITY), false, true, Dict{String, Task}())
+
+# FileWatching's folder watches are global to the process,
+#    so they're reference-counted to avoid one FileCacher unwatching another's folders.
+const WATCHED_FOLDER_COUNTS = Dict{String, Int}()
+const WATCHED_FOLDER_LOCK = ReentrantLock()
+function acquire_folder_watch(folder::String)
+    lock(WATCHED_FOLDER_LOCK) do
+        WATCHED_FOLDER_COUNTS[folder] = get(WATCHED_FOLDER_COUNTS, folder, 0) + 1
+    end
+    return nothing
+end
+function release_folder_watch(folder::String)
+    lock(WATCHED_FOLDER_LOCK) do
+        n = WATCHED_FOLDER_COUNTS[folder] - 1
+        if n > 0
+            WATCHED_FOLDER_COUNTS[folder] = n
+        else
+            delete!(WATCHED_FOLDER_COUNTS, folder)
+            FileWatching.unwatch_folder(folder)
+        end
+    end
+    return nothing
+end
+"Resets the OS watch on a folder after an error, unless another watcher is still using it"
+function reset_folder_watch(folder::String)
+    lock(WATCHED_FOLDER_LOCK) do
+        if get(WATCHED_FOLDER_COUNTS, folder, 0) == 1
+            FileWatching.unwatch_folder(folder)
+        end
+    end
+    return nothing
+end
+
+function watch_folder!(w::FileCacherWatcher, folder::String)
+    # Replace a task that died unexpectedly.
+    if haskey(w.folders, folder) && istaskdone(w.folders[folder])
+        delete!(w.folders, folder)
+    end
+    if !haskey(w.folders, folder)
+        w.folders[folder] = @async run_folder_watcher(w, folder)
+    end
+    return nothing
+end
+"Restarts any folder-watching tasks that died unexpectedly; returns whether there were any"
+function restart_dead_folder_watchers!(w::FileCacherWatcher)::Bool
+    dead_folders = [ f for (f, task) in w.folders if istaskdone(task) ]
+    foreach(f -> watch_folder!(w, f), dead_folders)
+    return !isempty(dead_folders)
+end
+function run_folder_watcher(w::FileCacherWatcher, folder::String)
+    acquire_folder_watch(folder)
+    try
+        retry_seconds = FILE_WATCH_RETRY_MIN_SECONDS
+        while @atomic w.is_running
+            try
+                (file_name, event) = FileWatching.watch_folder(folder, FILE_WATCH_TIMEOUT_SECONDS)
+                if !event.timedout && (event.changed || event.renamed)
+                    if !try_push!(w.events, normpath(joinpath(folder, file_name)))
+                        @atomic w.missed_events = true
+                    end
+                end
+                retry_seconds = FILE_WATCH_RETRY_MIN_SECONDS
+            catch e
+                # Probably the folder was deleted; fall back to checking every file,
+                #    and keep trying to watch it in case it comes back.
+                @atomic w.missed_events = true
+                if retry_seconds == FILE_WATCH_RETRY_MIN_SECONDS
+                    @warn "Error watching folder '$folder' for changes; retrying" ex=(e, catch_backtrace())
+                end
+                reset_folder_watch(folder)
+                # Sleep in small steps so that closing the watcher isn't held up.
+                wake_time = time() + retry_seconds
+                while (@atomic w.is_running) && (time() < wake_time)
+                    sleep(clamp(wake_time - time(), 0.001, FILE_WATCH_TIMEOUT_SECONDS))
+                end
+                retry_seconds = min(retry_seconds * 2, FILE_WATCH_RETRY_MAX_SECONDS)
+            end
+        end
+    finally
+        release_folder_watch(folder)
+    end
+end
+
+function Base.close(w::FileCacherWatcher)
+    @atomic w.is_running = false
+    foreach(task -> istaskfailed(task) || wait(task), values(w.folders))
+    empty!(w.folders)
+    return nothing
+end
+
+
+##   CachedDataFuture -- a file being loaded in the background   ##
+
+"
+A file being loaded on another thread, from `get_cached_data()`.
+Wait for it with `fetch()`, which returns the data or `nothing` (just like `get_cached_data!()`).
+"
+struct CachedDataFuture{TCached}
+    path::String
+    task::Task # Returns the (data, dependent_files) from the FileCacher's reload/error response
+end
+Base.isready(f::CachedDataFuture) = istaskdone(f.task)
+function Base.wait(f::CachedDataFuture)
+    # A failed load is reported by the FileCacher when it finishes the load, not here.
+    try
+        wait(f.task)
+    catch e
+        (e isa TaskFailedException) || rethrow()
+    end
+    return nothing
+end
+function Base.fetch(f::CachedDataFuture{TCached})::Optional{TCached} where {TCached}
+    wait(f)
+    istaskfailed(f.task) && return nothing
+    (data, _) = fetch(f.task)
+    return (data isa TCached) ? data : nothing
+end
+export CachedDataFuture
+
+
+##   FileCacheIndex -- a persistent record of processed files, for warm starts   ##
+
+"The state of one file when it was processed"
+struct FileCacheIndexFile
+    path::String
+    mtime::Float64
+    byte_size::Int64
+    content_hash::UInt32 # CRC-32C
+end
+function FileCacheIndexFile(path::AbstractString)
+    st = stat(path)
+    return FileCacheIndexFile(path, st.mtime, st.size, open(crc32c, path))
+end
+
+"A processed file, its dependent files, and where its processed artifact was saved"
+struct FileCacheIndexEntry
+    files::Vector{FileCacheIndexFile} # The main file comes first
+    artifact_path::String
+end
+
+"Bump this whenever the index's binary layout changes, to invalidate old indices"
+const FILE_CACHE_INDEX_VERSION = UInt32(1)
+
+"
+An on-disk index of processed files, so that a FileCacher can skip re-processing unchanged files
+    when the program starts up again.
+It can be used from multiple threads.
+"
+mutable struct FileCacheIndex
+    path::String
+    entries::Dict{String, FileCacheIndexEntry}
+    is_dirty::Bool
+    lock::ReentrantLock
+end
+function FileCacheIndex(path::AbstractString)
+    entries = Dict{String, FileCacheIndexEntry}()
+    if isfile(path)
+        try
+            reader = BinaryReader(read(path))
+            if read_binary(reader, UInt32) == FILE_CACHE_INDEX_VERSION
+                entries = read_binary(reader, Dict{String, FileCacheIndexEntry})
+            end
+        catch e
+            @warn "File cache index '$path' is corrupt; starting a new one" ex=(e, catch_backtrace())
+        end
+    end
+    return FileCacheIndex(path, entries, false, ReentrantLock())
+end
+
+"Saves the index to disk, if anything changed"
+function save_file_cache_index(index::FileCacheIndex)
+    lock(index.lock) do
+        index.is_dirty || return nothing
+
+        # Write to a temp file first, so a crash doesn't leave a half-written index.
+        mkpath(dirname(index.path))
+        temp_path = index.path * ".tmp"
+        open(temp_path, "w") do io
+            writer = BinaryWriter(io)
+            write_binary(writer, FILE_CACHE_INDEX_VERSION)
+            write_binary(writer, index.entries)
+        end
+        mv(temp_path, index.path, force=true)
+        index.is_dirty = false
+    end
+    return nothing
+end
+
+"
+Checks whether a file is unchanged since it was indexed.
+If only its modified time changed (e.x. from a version-control checkout), returns an updated record.
+Returns `nothing` if the file changed.
+"
+function check_file_cache_index_file(f::FileCacheIndexFile)::Optional{FileCacheIndexFile}
+    isfile(f.path) || return nothing
+    st = stat(f.path)
+    if st.size != f.byte_size
+        return nothing
+    elseif st.mtime == f.mtime
+        return f
+    elseif open(crc32c, f.path) == f.content_hash
+        return FileCacheIndexFile(f.path, st.mtime, f.byte_size, f.content_hash)
+    else
+        return nothing
+    end
+end
+
+
+##   FileCacherStats -- for tuning a FileCacher   ##
+
+"Counts how a FileCacher has been used, to help you tune its byte budget"
+mutable struct FileCacherStats
+    n_hits::Int
+    n_misses::Int
+    n_evictions::Int
+end
+FileCacherStats() = FileCacherStats(0, 0, 0)
+Base.show(io::IO, s::FileCacherStats) = print(io,
+    "FileCacherStats<", s.n_hits, " hits, ", s.n_misses, " misses, ", s.n_evictions, " evictions>"
+)
+export FileCacherStats
+
+
 ##   FileCacher -- manages a set of CachedData   ##
 
 "
@@ -63,6 +321,8 @@ Keeps track of file data of a certain type and automatically checks it for chang
     * Ideally, call this every frame.
     * If at least one file changed, it returns true, and also raises a callback to reload each changed file.
 * Get a file with `get_cached_data!()`. You can provide both relative and absolute paths.
+* Load files in the background with `get_cached_data()` (which returns a `CachedDataFuture`) or `prefetch!()`.
+    * Background loads are finished on the calling thread, in `check_disk_modifications!()` or `finish_cached_loads!()`.
 * Get the canonical representation of a file path within the cacher with `get_cached_path()`.
 
 You can configure the cacher in a few ways:
@@ -79,6 +339,30 @@ You can configure the cacher in a few ways:
      to prevent them from all checking the disk at once.
 * `relative_path` is the prefix for relative paths.
   * By default, it's the process's current location.
+* `watch_files`, if true, uses OS notifications to find changed files instead of periodically checking each one.
+  * Background Tasks watch each relevant folder, and `check_disk_modifications!()` only looks at files they reported.
+  * The Tasks run on the thread that creates them (i.e. that loads files), so always use the cacher from that thread,
+      and don't use watching FileCachers from several threads at once.
+  * `check_interval_ms` is ignored in this mode.
+  * Call `close()` on the cacher when you're done with it, to stop the Tasks.
+* `max_concurrent_loads` limits how many background loads can run at once.
+  * Background loads call `reload_response` and `error_response` on other threads, so they must be thread-safe.
+* `on_loaded(path, data)`, if given, is called after a background load finishes,
+     on the thread that finishes it (usually the main one). For example, this is where you can upload to the GPU.
+* `byte_budget`, if given, limits the total size of the cached data.
+  * When the cache goes over budget, the least-recently-used data is evicted, and passed to `close_response(path, data)`.
+  * The size of each piece of data is measured with `size_response(data) -> n_bytes`, by default `Base.summarysize()`.
+  * Keep some data from ever being evicted with `pin_cached_data!()`, and undo it with `unpin_cached_data!()`.
+  * Hits, misses, and evictions are counted in the `stats` field.
+* `index_path`, along with `save_artifact_response(data, artifact_path)` and `load_artifact_response(artifact_path) -> data`,
+     enables warm starts: processed data is saved to disk and reused by later runs, as long as its files haven't changed.
+  * After `reload_response` succeeds, `save_artifact_response` saves the processed data to a temp file,
+      which is then moved into `artifact_folder`.
+      If the file or its dependencies were edited while being processed, nothing is saved.
+  * When a file is first requested and its files' size, modified time, and content hash match the index,
+      `load_artifact_response` is called instead of `reload_response`.
+      For example, it could memory-map a baked texture with `BinaryReader`.
+  * The index is saved by `close()`, or manually with `save_file_cache_index()`.
 "
 @kwdef mutable struct FileCacher{TCached}
     reload_response::Base.Callable # (path[, old]) -> new[, dependent_files]
@@ -87,15 +371,51 @@ You can configure the cacher in a few ways:
     relative_path::String = pwd()
     check_interval_ms::IntervalU = 3000:5000
 
+    watch_files::Bool = false
+    max_concurrent_loads::Int = max(1, Threads.nthreads() - 1)
+    on_loaded::Optional{Base.Callable} = nothing # (path, data) -> nothing
+
+    byte_budget::Optional{Int} = nothing
+    size_response::Base.Callable = Base.summarysize # (data) -> n_bytes
+    close_response::Base.Callable = default_cache_close_response # (path, data) -> nothing
+    stats::FileCacherStats = FileCacherStats()
+
+    index_path::Optional{String} = nothing
+    artifact_folder::Optional{String} = isnothing(index_path) ? nothing : joinpath(dirname(index_path), "artifacts")
+    save_artifact_response::Optional{Base.Callable} = nothing # (data, artifact_path) -> nothing
+    load_artifact_response::Optional{Base.Callable} = nothing # (artifact_path) -> data
+
     files::Dict{AbstractString, CachedData{TCached}} = Dict() # Stored as their absolute, canonical paths.
     buffer::Vector{AbstractString} = [ ] # Used within some functions
+    watcher::Optional{FileCacherWatcher} = nothing
+    changed_files_buffer::Set{String} = Set{String}()
+
+    load_semaphore::Base.Semaphore = Base.Semaphore(max_concurrent_loads)
+    loading::Dict{String, CachedDataFuture{TCached}} = Dict() # Background loads that haven't been finished yet
+
+    total_byte_size::Int = 0
+    pinned::Set{String} = Set{String}()
+    lru::PriorityQueue{String, UInt64} = PriorityQueue{String, UInt64}() # Unpinned data, by last access
+    access_counter::UInt64 = 0
+
+    index::Optional{FileCacheIndex} = isnothing(index_path) ? nothing : FileCacheIndex(index_path)
+end
+
+function Base.close(fc::FileCacher)
+    foreach(wait, values(fc.loading))
+    finish_cached_loads!(fc)
+    if exists(fc.watcher)
+        close(fc.watcher)
+        fc.watcher = nothing
+    end
+    save_file_cache_index(fc)
 end
-#TODO: Rewrite this so a separate Task constantly checks all the files, sleeping in between each one
 
 function default_cache_error_response(path, exception, trace, old_data = nothing)
     @error "Unable to load $path." ex=(exception, trace)
     return nothing
 end
+default_cache_close_response(path, data) = nothing
 function get_cached_path(fc::FileCacher, relative_path::AbstractString)::String
     if isabspath(relative_path)
         return normpath(string(relative_path))
@@ -109,7 +429,9 @@ function make_data_cache( fc::FileCacher{TCached},
                           data_path::AbstractString,
                           dependent_files
                         )::CachedData{TCached} where {TCached}
-    return CachedData(
+    tracked_byte_size::Int = bp_memory_tracking_enabled() ? Base.summarysize(data) : 0
+    track_memory!(:file_cacher, tracked_byte_size)
+    cd = CachedData(
         data,
         # Get the "last-modified" time for each dependent file, plus the main one.
         let paths = tuple((get_cached_path(fc, p) for p in (data_path, dependent_files...))...),
@@ -118,39 +440,276 @@ function make_data_cache( fc::FileCacher{TCached},
         end,
         get_cached_path(fc, data_path),
         now(),
-        Millisecond(rand(fc.check_interval_ms))
+        Millisecond(rand(fc.check_interval_ms)),
+        tracked_byte_size,
+        exists(fc.byte_budget) ? Int(fc.size_response(data)) : 0,
+        zero(UInt64)
     )
+
+    if fc.watch_files
+        if isnothing(fc.watcher)
+            fc.watcher = FileCacherWatcher()
+        end
+        for file_path in keys(cd.files)
+            watch_folder!(fc.watcher, dirname(file_path))
+        end
+    end
+
+    return cd
+end
+
+"Puts some data into the cache, evicting old data if it's now over budget"
+function add_cached_data!(fc::FileCacher{TCached}, path::AbstractString,
+                          data::TCached, dependent_files) where {TCached}
+    cd = make_data_cache(fc, data, path, dependent_files)
+    fc.files[path] = cd
+    fc.total_byte_size += cd.byte_size
+    touch_cached_data!(fc, path)
+    enforce_cache_budget!(fc, path)
+    return nothing
+end
+"Takes some data out of the cache, without closing it"
+function remove_cached_data!(fc::FileCacher{TCached}, path::AbstractString)::CachedData{TCached} where {TCached}
+    cd = pop!(fc.files, path)
+    untrack_memory!(:file_cacher, cd.tracked_byte_size)
+    fc.total_byte_size -= cd.byte_size
+    if haskey(fc.lru, path)
+        delete!(fc.lru, path)
+    end
+    return cd
+end
+"Marks some cached data as the most-recently-used"
+function touch_cached_data!(fc::FileCacher, path::AbstractString)
+    fc.access_counter += 1
+    fc.files[path].last_access = fc.access_counter
+    if !in(path, fc.pinned)
+        fc.lru[path] = fc.access_counter
+    end
+end
+"Evicts the least-recently-used data until the cache is within budget, except for `keep_path`"
+function enforce_cache_budget!(fc::FileCacher, keep_path::Optional{AbstractString} = nothing)
+    isnothing(fc.byte_budget) && return nothing
+    while (fc.total_byte_size > fc.byte_budget) && !isempty(fc.lru)
+        (path, last_access) = peek(fc.lru)
+        if path == keep_path
+            break # It's the most recently used, so nothing else is left
+        end
+
+        cd = remove_cached_data!(fc, path)
+        fc.stats.n_evictions += 1
+        fc.close_response(path, cd.instance)
+    end
+    return nothing
+end
+
+"
+Prevents the given file's data from being evicted, even if it isn't loaded yet.
+"
+function pin_cached_data!(fc::FileCacher, path::AbstractString)
+    full_path = get_cached_path(fc, path)
+    push!(fc.pinned, full_path)
+    if haskey(fc.lru, full_path)
+        delete!(fc.lru, full_path)
+    end
+    return nothing
+end
+"
+Allows the given file's data to be evicted again.
+"
+function unpin_cached_data!(fc::FileCacher, path::AbstractString)
+    full_path = get_cached_path(fc, path)
+    delete!(fc.pinned, full_path)
+    if haskey(fc.files, full_path)
+        fc.lru[full_path] = fc.files[full_path].last_access
+        enforce_cache_budget!(fc)
+    end
+    return nothing
+end
+
+"
+Loads a file (or a fallback if it throws), returning the data and its dependent files.
+If the data isn't a `TCached`, then it couldn't be loaded.
+"
+function load_file_data(fc::FileCacher{TCached}, path::AbstractString, old_data...)::Tuple where {TCached}
+    uses_index = exists(fc.index) && exists(fc.save_artifact_response) && exists(fc.load_artifact_response)
+
+    # On a first load, try to use the processed data from a previous run.
+    if uses_index && isempty(old_data)
+        indexed = load_indexed_artifact(fc, path)
+        if exists(indexed)
+            return indexed
+        end
+    end
+
+    # Fingerprint the file before processing it, so that edits made during processing
+    #    aren't recorded in the index next to an artifact built from the old contents.
+    processing_start_time = time()
+    source_file = uses_index ? try_fingerprint_file(path) : nothing
+
+    result = try
+        r = fc.reload_response(path, old_data...)
+        (data, dependent_files) = (r isa Tuple{TCached, Any}) ? r : (r, ())
+        if exists(source_file) && (data isa TCached)
+            save_indexed_artifact(fc, path, data, dependent_files,
+                                  source_file, processing_start_time)
+        end
+        r
+    catch e
+        fc.error_response(path, e, catch_backtrace(), old_data...)
+    end
+    return (result isa Tuple{TCached, Any}) ? result : (result, ())
+end
+
+"Loads a file's processed artifact from a previous run, if its files haven't changed since then"
+function load_indexed_artifact(fc::FileCacher{TCached}, path::AbstractString)::Optional{Tuple} where {TCached}
+    index::FileCacheIndex = fc.index
+    entry = lock(() -> get(index.entries, path, nothing), index.lock)
+    isnothing(entry) && return nothing
+    isfile(entry.artifact_path) || return nothing
+
+    checked_files = map(check_file_cache_index_file, entry.files)
+    any(isnothing, checked_files) && return nothing
+    if checked_files != entry.files
+        lock(index.lock) do
+            index.entries[path] = FileCacheIndexEntry(checked_files, entry.artifact_path)
+            index.is_dirty = true
+        end
+    end
+
+    data = try
+        fc.load_artifact_response(entry.artifact_path)
+    catch e
+        @warn "Unable to load processed artifact for $path; processing it from scratch" ex=(e, catch_backtrace())
+        return nothing
+    end
+    return (data isa TCached) ? (data, map(f -> f.path, entry.files[2:end])) : nothing
+end
+"Gets a file's `FileCacheIndexFile`, or `nothing` if it can't be read"
+function try_fingerprint_file(path::AbstractString)::Optional{FileCacheIndexFile}
+    try
+        return FileCacheIndexFile(path)
+    catch
+        return nothing
+    end
+end
+
+"
+Gets the name of a file's processed artifact.
+It contains the (sanitized) source path itself, so different files can't overwrite each other's artifacts,
+    and a hash of the full path to tell apart paths which sanitize to the same name.
+"
+function get_artifact_file_name(path::AbstractString)::String
+    MAX_NAME_LENGTH = 128 # Stay well under common file-system limits
+    sanitized = replace(path, r"[^A-Za-z0-9_.-]" => "_")
+    if length(sanitized) > MAX_NAME_LENGTH
+        sanitized = last(sanitized, MAX_NAME_LENGTH)
+    end
+    return string(sanitized, "-", string(crc32c(path), base=16, pad=8), ".artifact")
+end
+
+"
+Saves a file's processed data for future runs, and records it in the index.
+`source_file` is the file's fingerprint from before it was processed;
+    if it (or one of its dependencies) was modified since `processing_start_time`,
+    the data is out of date and isn't indexed.
+"
+function save_indexed_artifact(fc::FileCacher, path::AbstractString, data, dependent_files,
+                               source_file::FileCacheIndexFile, processing_start_time::Float64)
+    index::FileCacheIndex = fc.index
+    artifact_path = joinpath(fc.artifact_folder, get_artifact_file_name(path))
+    try
+        files = map(FileCacheIndexFile, [ path, (get_cached_path(fc, p) for p in dependent_files)... ])
+        if (files[1] != source_file) ||
+           any(f -> f.mtime >= processing_start_time, @view files[2:end])
+            # It'll be processed again on the next load.
+            return nothing
+        end
+
+        # Write to a temp file first, so a crash doesn't leave a half-written artifact.
+        mkpath(fc.artifact_folder)
+        temp_path = artifact_path * ".tmp"
+        fc.save_artifact_response(data, temp_path)
+        mv(temp_path, artifact_path, force=true)
+
+        lock(index.lock) do
+            # Just in case two paths still share an artifact, drop the other one's entry.
+            filter!(kvp -> (kvp[1] == path) || (kvp[2].artifact_path != artifact_path),
+                    index.entries)
+            index.entries[path] = FileCacheIndexEntry(files, artifact_path)
+            index.is_dirty = true
+        end
+    catch e
+        @warn "Unable to save processed artifact for $path" ex=(e, catch_backtrace())
+    end
+    return nothing
+end
+
+"Saves the cacher's index of processed files to disk, if it has one and anything changed"
+function save_file_cache_index(fc::FileCacher)
+    if exists(fc.index)
+        save_file_cache_index(fc.index)
+    end
+    return nothing
 end
 
 function check_disk_modifications!(fc::FileCacher{TCached})::Bool where {TCached}
-    any_changes::Bool = false
+    finish_cached_loads!(fc)
 
     empty!(fc.buffer)
     current_keys = fc.buffer
-    append!(current_keys, keys(fc.files))
 
+    # When watching files, only check the ones that were reported as changed.
+    if fc.watch_files
+        watcher = fc.watcher
+        isnothing(watcher) && return false
+        # The watching Tasks share this thread, so give them a chance to report any new events.
+        yield()
+        if restart_dead_folder_watchers!(watcher)
+            # Changes may have been missed while the task was dead.
+            @atomic watcher.missed_events = true
+        end
+
+        changed_files = fc.changed_files_buffer
+        empty!(changed_files)
+        while true
+            changed_file = try_pop!(watcher.events)
+            isnothing(changed_file) && break
+            push!(changed_files, changed_file)
+        end
+
+        if @atomic watcher.missed_events
+            @atomic watcher.missed_events = false
+            append!(current_keys, keys(fc.files))
+        elseif isempty(changed_files)
+            return false
+        else
+            for (path, data) in fc.files
+                if any(f -> f in changed_files, keys(data.files))
+                    push!(current_keys, path)
+                end
+            end
+        end
+    else
+        append!(current_keys, keys(fc.files))
+    end
+
+    any_changes::Bool = false
     for path in current_keys
+        # Reloading one file may have evicted another.
+        haskey(fc.files, path) || continue
         data = fc.files[path]
-        if check_disk_modifications!(data)
+        has_changed = fc.watch_files ?
+                          check_disk_modifications!(data.files) :
+                          check_disk_modifications!(data)
+        if has_changed
             any_changes = true
 
-            delete!(fc.files, path)
-
-            # Load the new data (or a fallback if it throws).
-            result = try
-                fc.reload_response(path, data.instance)
-            catch e
-                fc.error_response(path, e, catch_backtrace(), data.instance)
-            end
-            (new_data, new_dependent_files) = if result isa Tuple{TCached, Any}
-                result
-            else
-                (result, ())
-            end
+            remove_cached_data!(fc, path)
+            (new_data, new_dependent_files) = load_file_data(fc, path, data.instance)
 
             # Replace the data in the cache.
             if new_data isa TCached
-                fc.files[path] = make_data_cache(fc, new_data, path, new_dependent_files)
+                add_cached_data!(fc, path, new_data, new_dependent_files)
             end
         end
     end
@@ -160,30 +719,33 @@ end
 
 "
 Retrieves the given file data, using a cached version if available.
+If the file is being loaded in the background, this waits for it.
 
 Returns `nothing` if the file can't be loaded and no fallback error value was provided to the cacher.
 "
 function get_cached_data!(fc::FileCacher{TCached}, path::AbstractString)::Optional{TCached} where {TCached}
     full_path = get_cached_path(fc, path)
 
+    if haskey(fc.loading, full_path)
+        future = fc.loading[full_path]
+        wait(future)
+        finish_cached_loads!(fc)
+        # Loading was already counted as a miss.
+        # It might have been evicted immediately, so return the loaded data directly.
+        return fetch(future)
+    end
+
     if haskey(fc.files, full_path)
+        fc.stats.n_hits += 1
+        touch_cached_data!(fc, full_path)
         return fc.files[full_path].instance
     else
-        # Load the file data (or a fallback if it throws).
-        result = try
-            fc.reload_response(full_path)
-        catch e
-            fc.error_response(full_path, e, catch_backtrace(), data)
-        end
-        (file_data, dependent_files) = if result isa Tuple{TCached, Any}
-            result
-        else
-            (result, ())
-        end
+        fc.stats.n_misses += 1
+        (file_data, dependent_files) = load_file_data(fc, full_path)
 
         # Put the data in the cache and then return it.
         if file_data isa TCached
-            fc.files[full_path] = make_data_cache(fc, file_data, full_path, dependent_files)
+            add_cached_data!(fc, full_path, file_data, dependent_files)
             return file_data
         else
             return nothing
@@ -191,7 +753,93 @@ function get_cached_data!(fc::FileCacher{TCached}, path::AbstractString)::Option
     end
 end
 
+"
+Starts loading the given file on another thread, unless it's already cached or loading.
+Returns a `CachedDataFuture` for the result.
+
+The file is added to the cache when the load is finished by `check_disk_modifications!()`,
+    `finish_cached_loads!()`, or `get_cached_data!()`.
+"
+function get_cached_data(fc::FileCacher{TCached}, path::AbstractString)::CachedDataFuture{TCached} where {TCached}
+    full_path = get_cached_path(fc, path)
+
+    if haskey(fc.loading, full_path)
+        return fc.loading[full_path]
+    elseif haskey(fc.files, full_path)
+        fc.stats.n_hits += 1
+        touch_cached_data!(fc, full_path)
+        data = fc.files[full_path].instance
+        task = Task(() -> (data, ()))
+        schedule(task)
+        return CachedDataFuture{TCached}(full_path, task)
+    else
+        fc.stats.n_misses += 1
+        semaphore = fc.load_semaphore
+        task = Threads.@spawn Base.acquire(() -> load_file_data(fc, full_path), semaphore)
+        future = CachedDataFuture{TCached}(full_path, task)
+        fc.loading[full_path] = future
+        return future
+    end
+end
+
+"Starts loading each of the given files in the background; see `get_cached_data()`."
+function prefetch!(fc::FileCacher, paths)
+    for path in paths
+        get_cached_data(fc, path)
+    end
+    return nothing
+end
+
+"
+Adds any finished background loads into the cache, and raises `on_loaded` for them.
+Returns the number of loads that finished.
+"
+function finish_cached_loads!(fc::FileCacher{TCached})::Int where {TCached}
+    isempty(fc.loading) && return 0
+
+    empty!(fc.buffer)
+    finished_paths = fc.buffer
+    for (path, future) in fc.loading
+        if isready(future)
+            push!(finished_paths, path)
+        end
+    end
+
+    n_finished = length(finished_paths)
+    for path in finished_paths
+        future = pop!(fc.loading, path)
+        (file_data, dependent_files) = istaskfailed(future.task) ?
+                                           failed_load_data(fc, path, future.task) :
+                                           fetch(future.task)
+        if file_data isa TCached
+            add_cached_data!(fc, path, file_data, dependent_files)
+            if exists(fc.on_loaded)
+                fc.on_loaded(path, file_data)
+            end
+        end
+    end
+
+    return n_finished
+end
+"
+Handles a background load which threw outside of `load_file_data()`'s own error handling
+    (e.x. from the `error_response` itself), so that it doesn't stop other loads from finishing.
+Returns the fallback (data, dependent_files), like `load_file_data()`.
+"
+function failed_load_data(fc::FileCacher{TCached}, path::AbstractString, task::Task)::Tuple where {TCached}
+    try
+        r = fc.error_response(path, task.exception, task.backtrace)
+        return (r isa Tuple{TCached, Any}) ? r : (r, ())
+    catch e
+        default_cache_error_response(path, e, catch_backtrace())
+        return (nothing, ())
+    end
+end
+
 
 export FileCacher,
        load_uncached_data, close_cached_data, close_pooled_data,
-       get_cached_data!, check_disk_modifications!
\ No newline at end of file
+       get_cached_data!, check_disk_modifications!,
+       get_cached_data, prefetch!, finish_cached_loads!,
+       pin_cached_data!, unpin_cached_data!,
+       save_file_cache_index
@@ -0,0 +1,128 @@
+"Info about one frame that's handed to a `FramePipeline` simulation"
+struct PipelineFrame
+    frame_idx::Int
+    delta_seconds::Float32
+end
+export PipelineFrame
+
+# A simulation that threw, along with the state buffer it was using,
+#    so the buffer can be returned to the pipeline before the error is rethrown.
+struct PipelineFailure{TState}
+    state::TState
+    exception::CapturedException
+end
+
+
+"""
+Runs a game's simulation on a worker thread, some frames ahead of the rendering thread.
+
+Each in-flight frame has its own state buffer of type `TState`;
+    the simulation writes into one while the renderer reads from another,
+    so they never need to share data.
+
+ * `simulate_response(state::TState, frame::PipelineFrame)` runs on the worker thread.
+   It must not touch OpenGL, GUI, or Input.
+ * `prepare_response(state::TState, frame::PipelineFrame)` runs on the submitting thread,
+     just before the state is handed to the simulation.
+   Use it to copy input into the state.
+ * `make_state() -> TState` creates each buffer.
+ * `depth` is the number of frames that can be in flight at once.
+   A depth of 1 runs the simulation and the rendering back-to-back.
+   A depth of 2 renders frame N while simulating frame N+1, and so on.
+
+The handoff goes like this:
+ 1. `pipeline_submit!(p, frame)` starts simulating a new frame.
+    If every buffer is in use, it waits for one to be released.
+ 2. `pipeline_take!(p)::TState` waits for the oldest submitted frame to finish, and returns its state.
+ 3. Render from that state, then give it back with `pipeline_release!(p, state)`.
+
+Close the pipeline when you're done with it, to stop the worker Task.
+"""
+mutable struct FramePipeline{TState}
+    const simulate_response::Base.Callable
+    const prepare_response::Base.Callable
+    const depth::Int
+
+    const free_states::Channel{TState}
+    const requests::Channel{Tuple{TState, PipelineFrame}}
+    const results::Channel{Union{TState, PipelineFailure{TState}}}
+    const worker::Task
+
+    n_in_flight::Int
+
+    function FramePipeline{TState}(simulate_response::Base.Callable,
+                                   make_state::Base.Callable
+                                   ;
+                                   prepare_response::Base.Callable = (state, frame) -> nothing,
+                                   depth::Int = 2
+                                  ) where {TState}
+        @bp_check(depth > 0, "Pipeline depth must be at least 1, got ", depth)
+
+        free_states = Channel{TState}(depth)
+        for _ in 1:depth
+            put!(free_states, convert(TState, make_state()))
+        end
+
+        requests = Channel{Tuple{TState, PipelineFrame}}(depth)
+        results = Channel{Union{TState, PipelineFailure{TState}}}(depth)
+        worker = Threads.@spawn run_frame_pipeline(simulate_response, requests, results)
+
+        return new{TState}(simulate_response, prepare_response, depth,
+                           free_states, requests, results, worker,
+                           0)
+    end
+end
+export FramePipeline
+
+function run_frame_pipeline(simulate_response::Base.Callable,
+                            requests::Channel{Tuple{TState, PipelineFrame}},
+                            results::Channel{Union{TState, PipelineFailure{TState}}}
+                           ) where {TState}
+    for (state, frame) in requests
+        try
+            simulate_response(state, frame)
+            put!(results, state)
+        catch e
+            # Pass the error along to the render thread, which will rethrow it.
+            put!(results, PipelineFailure{TState}(state, CapturedException(e, catch_backtrace())))
+        end
+    end
+end
+
+"Starts simulating a new frame, waiting for a free state buffer if necessary"
+function pipeline_submit!(p::FramePipeline{TState}, frame::PipelineFrame) where {TState}
+    state::TState = take!(p.free_states)
+    p.prepare_response(state, frame)
+    put!(p.requests, (state, frame))
+    p.n_in_flight += 1
+    return nothing
+end
+"
+Waits for the oldest submitted frame to finish simulating, then returns its state.
+If the simulation threw, its state buffer is released and the error is rethrown,
+    so the pipeline can keep being used.
+"
+function pipeline_take!(p::FramePipeline{TState})::TState where {TState}
+    @bp_check(p.n_in_flight > 0, "No frames have been submitted to the pipeline")
+    result = take!(p.results)
+    p.n_in_flight -= 1
+    if result isa PipelineFailure
+        put!(p.free_states, result.state)
+        throw(result.exception)
+    end
+    return result
+end
+"Gives a state buffer back to the pipeline, after rendering from it"
+pipeline_release!(p::FramePipeline{TState}, state::TState) where {TState} = put!(p.free_states, state)
+
+"Gets whether the pipeline has as many frames in flight as it can handle"
+pipeline_is_full(p::FramePipeline) = (p.n_in_flight >= p.depth)
+
+export pipeline_submit!, pipeline_take!, pipeline_release!, pipeline_is_full
+
+"Stops the pipeline's worker Task, after it finishes any frames it's already working on"
+function Base.close(p::FramePipeline)
+    close(p.requests)
+    wait(p.worker)
+    return nothing
+end
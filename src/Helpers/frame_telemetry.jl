@@ -0,0 +1,219 @@
+"The timing and memory data for one recorded frame"
+struct FrameTelemetrySample
+    frame_idx::Int
+
+    # CPU time spent in each part of the frame:
+    input_seconds::Float32
+    update_seconds::Float32
+    gui_seconds::Float32
+    swap_seconds::Float32
+    wait_seconds::Float32
+    # The whole frame, including any time between the above sections:
+    frame_seconds::Float32
+
+    gc_seconds::Float32
+    allocated_bytes::Int64
+end
+export FrameTelemetrySample
+
+const FRAME_TELEMETRY_SECTIONS = (:input, :update, :gui, :swap, :wait)
+
+"
+Records per-frame timings into a fixed-size ring buffer, keeping the most recent frames.
+Recording does not allocate.
+
+Each frame, call `telemetry_begin_frame!()`, then `telemetry_mark!()` at the end of each section
+    (`:input`, `:update`, `:gui`, `:swap`, or `:wait`), then `telemetry_end_frame!()`.
+"
+mutable struct FrameTelemetry
+    const samples::Vector{FrameTelemetrySample}
+    const sort_buffer::Vector{Float32}
+    n_recorded::Int
+
+    # The frame currently being recorded:
+    frame_idx::Int
+    frame_start_ns::UInt64
+    last_mark_ns::UInt64
+    frame_gc::Base.GC_Num
+    section_ns::NTuple{length(FRAME_TELEMETRY_SECTIONS), UInt64}
+
+    function FrameTelemetry(capacity::Int = 1000)
+        @bp_check(capacity > 0, "Telemetry needs room for at least one frame")
+        return new(
+            Vector{FrameTelemetrySample}(undef, capacity),
+            Vector{Float32}(undef, capacity),
+            0,
+            0, 0, 0, Base.gc_num(),
+            ntuple(i -> zero(UInt64), length(FRAME_TELEMETRY_SECTIONS))
+        )
+    end
+end
+export FrameTelemetry
+
+"Starts recording a new frame"
+function telemetry_begin_frame!(t::FrameTelemetry, frame_idx::Int)
+    t.frame_idx = frame_idx
+    t.frame_gc = Base.gc_num()
+    t.frame_start_ns = time_ns()
+    t.last_mark_ns = t.frame_start_ns
+    t.section_ns = ntuple(i -> zero(UInt64), length(FRAME_TELEMETRY_SECTIONS))
+    return nothing
+end
+"
+Adds the time since the last mark (or the start of the frame) to the given section.
+The section may be marked more than once per frame; its times are summed.
+"
+function telemetry_mark!(t::FrameTelemetry, section::Symbol)
+    now_ns = time_ns()
+    section_idx = findfirst(==(section), FRAME_TELEMETRY_SECTIONS)
+    @bp_check(exists(section_idx), "Unknown telemetry section: ", section)
+    t.section_ns = Base.setindex(t.section_ns,
+                                 t.section_ns[section_idx] + (now_ns - t.last_mark_ns),
+                                 section_idx)
+    t.last_mark_ns = now_ns
+    return nothing
+end
+"Finishes recording the current frame, and adds it to the ring buffer"
+function telemetry_end_frame!(t::FrameTelemetry)
+    now_ns = time_ns()
+    gc_diff = Base.GC_Diff(Base.gc_num(), t.frame_gc)
+    to_seconds(ns) = Float32(ns / 1e9)
+
+    t.samples[mod1(t.n_recorded + 1, length(t.samples))] = FrameTelemetrySample(
+        t.frame_idx,
+        map(to_seconds, t.section_ns)...,
+        to_seconds(now_ns - t.frame_start_ns),
+        to_seconds(gc_diff.total_time),
+        gc_diff.allocd
+    )
+    t.n_recorded += 1
+    return nothing
+end
+
+export telemetry_begin_frame!, telemetry_mark!, telemetry_end_frame!
+
+
+"Gets the number of frames currently stored in the telemetry buffer"
+telemetry_count(t::FrameTelemetry) = min(t.n_recorded, length(t.samples))
+"Iterates over the stored frames, from oldest to newest"
+telemetry_samples(t::FrameTelemetry) = (
+    t.samples[mod1(i, length(t.samples))]
+      for i in (t.n_recorded - telemetry_count(t) + 1) : t.n_recorded
+)
+"Forgets all recorded frames"
+clear_telemetry!(t::FrameTelemetry) = (t.n_recorded = 0)
+
+export telemetry_count, telemetry_samples, clear_telemetry!
+
+
+"Statistics over the frames in a `FrameTelemetry`"
+struct FrameTelemetrySummary
+    n_frames::Int
+
+    mean_frame_seconds::Float32
+    max_frame_seconds::Float32
+    # The frame time which only 1% (or 0.1%) of frames are slower than.
+    low_1_percent_seconds::Float32
+    low_0_1_percent_seconds::Float32
+
+    mean_input_seconds::Float32
+    mean_update_seconds::Float32
+    mean_gui_seconds::Float32
+    mean_swap_seconds::Float32
+    mean_wait_seconds::Float32
+
+    total_gc_seconds::Float32
+    mean_allocated_bytes::Float64
+end
+export FrameTelemetrySummary
+
+"Computes statistics over the recorded frames"
+function telemetry_summary(t::FrameTelemetry)::FrameTelemetrySummary
+    n = telemetry_count(t)
+    if n < 1
+        return FrameTelemetrySummary(0, ntuple(i -> 0.0f0, 10)..., 0.0)
+    end
+
+    # Get the frame-time percentiles by sorting a copy of the frame times.
+    sorted_times = view(t.sort_buffer, 1:n)
+    for (i, sample) in enumerate(telemetry_samples(t))
+        sorted_times[i] = sample.frame_seconds
+    end
+    sort!(sorted_times)
+    percentile(p) = sorted_times[clamp(ceil(Int, n * p), 1, n)]
+
+    mean_of(field) = Float32(sum(getfield(s, field) for s in telemetry_samples(t)) / n)
+    return FrameTelemetrySummary(
+        n,
+        mean_of(:frame_seconds), sorted_times[end],
+        percentile(0.99), percentile(0.999),
+        mean_of(:input_seconds), mean_of(:update_seconds), mean_of(:gui_seconds),
+          mean_of(:swap_seconds), mean_of(:wait_seconds),
+        sum(s.gc_seconds for s in telemetry_samples(t)),
+        sum(s.allocated_bytes for s in telemetry_samples(t)) / n
+    )
+end
+export telemetry_summary
+
+
+"Writes the recorded frames as CSV, with one row per frame"
+function export_telemetry_csv(io::IO, t::FrameTelemetry)
+    println(io, join(fieldnames(FrameTelemetrySample), ','))
+    for sample in telemetry_samples(t)
+        join(io, (getfield(sample, f) for f in fieldnames(FrameTelemetrySample)), ',')
+        println(io)
+    end
+end
+export_telemetry_csv(path::AbstractString, t::FrameTelemetry) = open(io -> export_telemetry_csv(io, t), path, "w")
+
+"
+Writes the summary and the recorded frames as a JSON object, `{ \"summary\": {...}, \"frames\": [...] }`.
+Non-finite numbers, which JSON can't represent, are written as `null`.
+"
+function export_telemetry_json(io::IO, t::FrameTelemetry)
+    write_json_value(x::Integer) = print(io, x)
+    write_json_value(x::AbstractFloat) = print(io, isfinite(x) ? x : "null")
+    write_json_object(x) = begin
+        print(io, '{')
+        for (i, f) in enumerate(fieldnames(typeof(x)))
+            (i > 1) && print(io, ", ")
+            print(io, '"', f, "\": ")
+            write_json_value(getfield(x, f))
+        end
+        print(io, '}')
+    end
+
+    print(io, "{\n\"summary\": ")
+    write_json_object(telemetry_summary(t))
+    print(io, ",\n\"frames\": [")
+    for (i, sample) in enumerate(telemetry_samples(t))
+        print(io, (i > 1) ? ",\n    " : "\n    ")
+        write_json_object(sample)
+    end
+    print(io, "\n]\n}\n")
+end
+export_telemetry_json(path::AbstractString, t::FrameTelemetry) = open(io -> export_telemetry_json(io, t), path, "w")
+
+export export_telemetry_csv, export_telemetry_json
+
+
+"Displays a summary of the recorded frames with Dear ImGUI"
+function gui_frame_telemetry(t::FrameTelemetry)
+    s = telemetry_summary(t)
+    ms(seconds) = round(seconds * 1000, digits=2)
+    CImGui.Text("Frames: $(s.n_frames)")
+    CImGui.Text("Frame time: $(ms(s.mean_frame_seconds))ms avg, $(ms(s.max_frame_seconds))ms max")
+    CImGui.Text("1% low: $(ms(s.low_1_percent_seconds))ms    0.1% low: $(ms(s.low_0_1_percent_seconds))ms")
+    CImGui.Text("Input $(ms(s.mean_input_seconds))ms | Update $(ms(s.mean_update_seconds))ms | GUI $(ms(s.mean_gui_seconds))ms")
+    CImGui.Text("Swap $(ms(s.mean_swap_seconds))ms | Wait $(ms(s.mean_wait_seconds))ms")
+    CImGui.Text("GC: $(ms(s.total_gc_seconds))ms total, $(round(Int, s.mean_allocated_bytes)) bytes/frame")
+end
+
+"Displays one frame's count of issued vs skipped GL state changes with Dear ImGUI"
+function gui_state_change_counters(c::StateChangeCounters)
+    CImGui.Text("GL state changes (issued/skipped):")
+    CImGui.Text("  Render state $(c.n_render_state_issued)/$(c.n_render_state_skipped) | Programs $(c.n_program_binds_issued)/$(c.n_program_binds_skipped)")
+    CImGui.Text("  Meshes $(c.n_mesh_binds_issued)/$(c.n_mesh_binds_skipped) | Blocks $(c.n_block_binds_issued)/$(c.n_block_binds_skipped)")
+end
+
+export gui_frame_telemetry, gui_state_change_counters
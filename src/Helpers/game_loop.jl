@@ -1,3 +1,31 @@
+# Different ways the game loop can wait at the end of a frame, to respect `max_fps`.
+@bp_enum(FramePacingModes,
+    # Just call `sleep()`, never spinning.
+    # Julia's sleep has millisecond granularity plus scheduler jitter,
+    #    so high framerates come out erratic.
+    sleep,
+    # Sleep until `pacing_spin_seconds` before the deadline, then spin-wait the rest.
+    sleep_then_spin,
+    # Like `sleep_then_spin`, but the spin time is picked automatically
+    #    by measuring how much `sleep()` tends to overshoot.
+    adaptive
+)
+export FramePacingModes, E_FramePacingModes
+
+"Settings for running `@game_loop` without a visible window, e.x. for benchmarks"
+Base.@kwdef struct HeadlessSettings
+    # The number of frames to run before quitting.
+    n_frames::Int
+    # The fixed time step of every frame.
+    delta_seconds::Float32 = 1/60
+    # A file of recorded input (see `save_input_recording()`) to replay during the run.
+    input_replay_path::Optional{String} = nothing
+    # A file to write the frame telemetry to.
+    # It's written as JSON if the extension is '.json', otherwise CSV.
+    telemetry_path::Optional{String} = nothing
+end
+export HeadlessSettings
+
 "The game loop's state and parameters"
 Base.@kwdef mutable struct GameLoop
     # Game stuff:
@@ -11,6 +39,35 @@ Base.@kwdef mutable struct GameLoop
     frame_idx::Int = 0
     delta_seconds::Float32 = 0
 
+    # Fixed-update stuff:
+    fixed_delta_seconds::Float32 = 0
+    fixed_update_idx::Int = 0
+    fixed_update_accumulator::Float64 = 0 # Seconds of real time that haven't been simulated yet
+    # How far the rendered frame is in between the previous fixed update and the next one, from 0 to 1.
+    # Use this to interpolate the state of fixed-update objects for smooth rendering.
+    fixed_update_interpolation::Float32 = 0
+    # The number of fixed updates that were skipped because the game couldn't keep up.
+    n_dropped_fixed_updates::Int = 0
+
+    # Frame pacing stuff:
+    # How late the last frame ended compared to the `max_fps` deadline, in seconds.
+    # Negative if it woke up early.
+    pacing_error_seconds::Float32 = 0
+    # A running average of the absolute pacing error, in seconds.
+    pacing_jitter_seconds::Float32 = 0
+    # For the 'adaptive' pacing mode: running statistics on how much `sleep()` overshoots.
+    sleep_overshoot_mean_seconds::Float32 = 0.001
+    sleep_overshoot_deviation_seconds::Float32 = 0.0005
+
+    # Pipelined mode stuff:
+    # The simulated state to render this frame, if `pipeline` is set.
+    # It's `nothing` for the first few frames, while the pipeline fills up.
+    render_state::Any = nothing
+
+    # Headless mode stuff:
+    headless::Optional{HeadlessSettings} = nothing
+    input_replay::Optional{InputRecording} = nothing
+
 
     ##################################
     #   Below are fields you can set!
@@ -23,6 +80,164 @@ Base.@kwdef mutable struct GameLoop
     # 'delta_seconds' will be capped at this value, even if the frame took longer.
     # This stops the game from significantly jumping after one hang.
     max_frame_duration::Float32 = 0.1
+
+    # How the game loop waits to respect `max_fps`.
+    pacing_mode::E_FramePacingModes = FramePacingModes.sleep
+    # For the 'sleep_then_spin' pacing mode: the time at the end of each wait that is spent spinning.
+    pacing_spin_seconds::Float32 = 0.002
+
+    # Set this in SETUP to run your simulation on a worker thread, ahead of rendering.
+    # Each frame, a new frame is submitted to it before the `LOOP` block runs,
+    #    and the oldest finished frame's state is put into `render_state`.
+    pipeline::Optional{FramePipeline} = nothing
+
+    # Set this to record the timing of each frame's sections (input, update, GUI, swap, and wait).
+    telemetry::Optional{FrameTelemetry} = nothing
+    # If true, and `telemetry` is set, then a summary of it is displayed in its own GUI window.
+    show_telemetry::Bool = false
+
+    # Set this to record the Input service's values every frame.
+    # You can save it in TEARDOWN with `save_input_recording()`, then replay it in `HEADLESS` mode.
+    input_recording::Optional{InputRecording} = nothing
+
+    # The number of FIXED_UPDATE steps per second.
+    fixed_update_rate::Float64 = 60
+    # The maximum number of FIXED_UPDATE steps in one frame.
+    # If the game falls further behind than this, the extra steps are dropped,
+    #    so that slow updates don't snowball into a "spiral of death".
+    max_fixed_updates_per_frame::Int = 8
+end
+
+"
+Adds the last frame's time to the fixed-update accumulator,
+    and returns how many fixed updates to run this frame.
+"
+function game_loop_begin_fixed_updates!(loop::GameLoop)::Int
+    step_seconds = 1 / loop.fixed_update_rate
+    loop.fixed_delta_seconds = Float32(step_seconds)
+    loop.fixed_update_accumulator += loop.delta_seconds
+
+    n_steps = floor(Int, loop.fixed_update_accumulator / step_seconds)
+    if n_steps > loop.max_fixed_updates_per_frame
+        n_dropped = n_steps - loop.max_fixed_updates_per_frame
+        loop.n_dropped_fixed_updates += n_dropped
+        loop.fixed_update_accumulator -= n_dropped * step_seconds
+        n_steps = loop.max_fixed_updates_per_frame
+    end
+    return n_steps
+end
+"Records that one fixed update has finished"
+function game_loop_end_fixed_update!(loop::GameLoop)
+    loop.fixed_update_accumulator -= 1 / loop.fixed_update_rate
+    loop.fixed_update_idx += 1
+end
+"Computes the interpolation between fixed updates, after they've all run for this frame"
+function game_loop_end_fixed_updates!(loop::GameLoop)
+    loop.fixed_update_interpolation = clamp(Float32(loop.fixed_update_accumulator * loop.fixed_update_rate),
+                                            0.0f0, 1.0f0)
+end
+
+"
+Waits until the given `time_ns()` timestamp, according to the loop's `pacing_mode`.
+Updates the pacing statistics, and returns the timestamp after waiting.
+"
+function game_loop_wait_until!(loop::GameLoop, target_ns::UInt64)::UInt64
+    now_ns::UInt64 = time_ns()
+    if now_ns < target_ns
+        # Pick how much time to leave for spinning at the end.
+        spin_seconds::Float64 = if loop.pacing_mode == FramePacingModes.sleep
+            0.0
+        elseif loop.pacing_mode == FramePacingModes.sleep_then_spin
+            loop.pacing_spin_seconds
+        elseif loop.pacing_mode == FramePacingModes.adaptive
+            # Leave room for a pessimistic sleep overshoot.
+            loop.sleep_overshoot_mean_seconds + (4 * loop.sleep_overshoot_deviation_seconds)
+        else
+            error("Unhandled case: ", loop.pacing_mode)
+        end
+
+        # Sleep coarsely. Julia can't sleep for less than a millisecond,
+        #    so the spinning modes leave any shorter waits to the spin loop.
+        is_spinning::Bool = (loop.pacing_mode != FramePacingModes.sleep)
+        sleep_seconds = ((target_ns - now_ns) / 1e9) - spin_seconds
+        if sleep_seconds >= (is_spinning ? 0.001 : 0.0)
+            sleep(sleep_seconds)
+            slept_ns = time_ns()
+
+            # Measure the overshoot.
+            overshoot_seconds = Float32(((slept_ns - now_ns) / 1e9) - sleep_seconds)
+            overshoot_error = abs(overshoot_seconds - loop.sleep_overshoot_mean_seconds)
+            loop.sleep_overshoot_mean_seconds = lerp(loop.sleep_overshoot_mean_seconds,
+                                                     overshoot_seconds, 0.1f0)
+            loop.sleep_overshoot_deviation_seconds = lerp(loop.sleep_overshoot_deviation_seconds,
+                                                          overshoot_error, 0.1f0)
+            now_ns = slept_ns
+        end
+
+        # Spin for the rest of the time.
+        if is_spinning
+            while now_ns < target_ns
+                ccall(:jl_cpu_pause, Cvoid, ())
+                now_ns = time_ns()
+            end
+        end
+    end
+
+    # Update the jitter statistic.
+    loop.pacing_error_seconds = Float32((Int64(now_ns) - Int64(target_ns)) / 1e9)
+    loop.pacing_jitter_seconds = lerp(loop.pacing_jitter_seconds,
+                                      abs(loop.pacing_error_seconds), 0.05f0)
+
+    return now_ns
+end
+
+"Submits this frame to the loop's pipeline, and takes the state to render if one is ready"
+function game_loop_pipeline_begin_frame!(loop::GameLoop)
+    pipeline::FramePipeline = loop.pipeline
+    pipeline_submit!(pipeline, PipelineFrame(loop.frame_idx, loop.delta_seconds))
+    if pipeline_is_full(pipeline)
+        loop.render_state = pipeline_take!(pipeline)
+    end
+end
+"Gives this frame's render state back to the loop's pipeline"
+function game_loop_pipeline_end_frame!(loop::GameLoop)
+    if exists(loop.render_state)
+        pipeline_release!(loop.pipeline, loop.render_state)
+        loop.render_state = nothing
+    end
+end
+
+"Configures the loop to run in headless mode"
+function game_loop_start_headless!(loop::GameLoop, settings::HeadlessSettings)
+    @bp_check(settings.n_frames > 0, "Headless game loop must run at least one frame")
+    loop.headless = settings
+    loop.telemetry = FrameTelemetry(settings.n_frames)
+    loop.max_fps = nothing
+    if exists(settings.input_replay_path)
+        loop.input_replay = load_input_recording(settings.input_replay_path)
+    end
+end
+"Finishes a headless run, writing out its telemetry"
+function game_loop_end_headless!(loop::GameLoop)
+    path = loop.headless.telemetry_path
+    if exists(path)
+        if lowercase(splitext(path)[2]) == ".json"
+            export_telemetry_json(path, loop.telemetry)
+        else
+            export_telemetry_csv(path, loop.telemetry)
+        end
+    end
+end
+
+"Displays the loop's telemetry in its own window, which the user can close"
+function game_loop_telemetry_gui!(loop::GameLoop)
+    is_open = Ref(true)
+    gui_window(() -> begin
+                   gui_frame_telemetry(loop.telemetry)
+                   gui_state_change_counters(loop.context.last_frame_state_counters)
+               end,
+               "Frame telemetry", is_open)
+    loop.show_telemetry = is_open[]
 end
 
 """
@@ -37,18 +252,37 @@ The syntax looks like this:
         v2i(1920, 1080), "My Window Title";
         debug_mode=true
     )
+    HEADLESS(
+        # Optional. Runs without a visible window, for a fixed number of frames,
+        #    with a fixed time step and optionally some replayed input.
+        # Pass the arguments for a `HeadlessSettings`.
+        # For example:
+        n_frames = 1000,
+        input_replay_path = "recorded_input.bin",
+        telemetry_path = "frames.csv"
+    )
 
     SETUP = begin
         # Julia code block that runs just before the loop.
         # Initialize your assets and game state, add custom fonts to CImGui, etc.
         # You can configure loop parameters by changing certain fields
         #    of the variable `LOOP::GameLoop`.
+        # To run your simulation on another thread, set `LOOP.pipeline` to a `FramePipeline`.
+    end
+    FIXED_UPDATE = begin
+        # Optional Julia code block that runs at a fixed rate (`LOOP.fixed_update_rate`),
+        #    zero or more times per frame, just before the `LOOP` block.
+        # Use `LOOP.fixed_delta_seconds` as the time step, for physics and other simulation.
+        # When rendering, use `LOOP.fixed_update_interpolation` to blend between
+        #    the previous and current simulation state.
+        # Runs in the same scope as `SETUP`, but don't `break` out of it.
     end
     LOOP = begin
         # Julia code block that runs inside the loop.
         # Runs in a `for` loop in the same scope as `SETUP`.
         # You should end the loop with a `break` statement --
         #   if you `return` or `throw`, then the `TEARDOWN` section won't run.
+        # If `LOOP.pipeline` is set, render from `LOOP.render_state`.
     end
     TEARDOWN = begin
         # Julia code block that runs after the loop.
@@ -69,7 +303,9 @@ macro game_loop(block)
     filter!(s -> !isa(s, LineNumberNode), statements)
 
     init_args = ()
+    headless_args = nothing
     setup_code = nothing
+    fixed_update_code = nothing
     loop_code = nothing
     teardown_code = nothing
     for statement in statements
@@ -78,11 +314,21 @@ macro game_loop(block)
                 error("Provided INIT more than once")
             end
             init_args = statement.args[2:end]
+        elseif Base.is_expr(statement, :call) && (statement.args[1] == :HEADLESS)
+            if exists(headless_args)
+                error("Provided HEADLESS more than once")
+            end
+            headless_args = statement.args[2:end]
         elseif Base.is_expr(statement, :(=)) && (statement.args[1] == :SETUP)
             if exists(setup_code)
                 error("Provided SETUP more than once")
             end
             setup_code = statement.args[2]
+        elseif Base.is_expr(statement, :(=)) && (statement.args[1] == :FIXED_UPDATE)
+            if exists(fixed_update_code)
+                error("Provided FIXED_UPDATE more than once")
+            end
+            fixed_update_code = statement.args[2]
         elseif Base.is_expr(statement, :(=)) && (statement.args[1] == :LOOP)
             if exists(loop_code)
                 error("Provided LOOP more than once")
@@ -99,6 +345,76 @@ macro game_loop(block)
     end
 
     loop_var = esc(:LOOP)
+    # The main loop is generated separately, so cleanup can be wrapped around it below.
+    expr_main_loop = quote
+        while true
+            exists($loop_var.telemetry) && telemetry_begin_frame!($loop_var.telemetry, $loop_var.frame_idx)
+            GLFW.PollEvents()
+
+            # Update/render.
+            service_Input_update()
+            if exists($loop_var.input_replay)
+                replay_input_frame($loop_var.input_replay, $loop_var.frame_idx + 1)
+            end
+            if exists($loop_var.input_recording)
+                record_input_frame!($loop_var.input_recording)
+            end
+            exists($loop_var.telemetry) && telemetry_mark!($loop_var.telemetry, :input)
+            service_GUI_start_frame()
+            exists($loop_var.telemetry) && telemetry_mark!($loop_var.telemetry, :gui)
+            $(if exists(fixed_update_code)
+                quote
+                    for _ in 1:game_loop_begin_fixed_updates!($loop_var)
+                        $(esc(fixed_update_code))
+                        game_loop_end_fixed_update!($loop_var)
+                    end
+                    game_loop_end_fixed_updates!($loop_var)
+                end
+            end)
+            if exists($loop_var.pipeline)
+                game_loop_pipeline_begin_frame!($loop_var)
+            end
+            $(esc(loop_code))
+            if exists($loop_var.pipeline)
+                game_loop_pipeline_end_frame!($loop_var)
+            end
+            exists($loop_var.telemetry) && telemetry_mark!($loop_var.telemetry, :update)
+            if exists($loop_var.telemetry) && $loop_var.show_telemetry
+                game_loop_telemetry_gui!($loop_var)
+            end
+            @bp_profile "service_GUI_end_frame" service_GUI_end_frame()
+            exists($loop_var.telemetry) && telemetry_mark!($loop_var.telemetry, :gui)
+            GLFW.SwapBuffers($loop_var.context.window)
+            exists($loop_var.telemetry) && telemetry_mark!($loop_var.telemetry, :swap)
+            reset_state_counters!($loop_var.context)
+
+            # Advance the timer.
+            $loop_var.frame_idx += 1
+            new_time::UInt = time_ns()
+            # Cap the framerate, by waiting if necessary.
+            if exists($loop_var.max_fps)
+                target_time = $loop_var.last_frame_time_ns + round(UInt64, 1e9 / $loop_var.max_fps)
+                new_time = game_loop_wait_until!($loop_var, target_time)
+            end
+            $loop_var.delta_seconds = Float32((new_time - $loop_var.last_frame_time_ns) / 1e9)
+            $loop_var.last_frame_time_ns = new_time
+            if exists($loop_var.telemetry)
+                telemetry_mark!($loop_var.telemetry, :wait)
+                telemetry_end_frame!($loop_var.telemetry)
+            end
+            # Cap the length of the next frame.
+            $loop_var.delta_seconds = min(Float32($loop_var.max_frame_duration),
+                                            $loop_var.delta_seconds)
+
+            # In headless mode, use a fixed time step and stop after a fixed number of frames.
+            if exists($loop_var.headless)
+                $loop_var.delta_seconds = $loop_var.headless.delta_seconds
+                if $loop_var.frame_idx >= $loop_var.headless.n_frames
+                    break
+                end
+            end
+        end
+    end
     do_body = :( (game_loop_impl_context::Context, ) -> begin
         # Set up the loop state object.
         $loop_var::GameLoop = GameLoop(
@@ -107,6 +423,14 @@ macro game_loop(block)
             service_basic_graphics=service_BasicGraphics_init(),
             service_gui=service_GUI_init()
         )
+        $(if exists(headless_args)
+            quote
+                # The window was created hidden; don't affect any other windows.
+                GLFW.DefaultWindowHints()
+                game_loop_start_headless!($loop_var, $(Expr(:call, HeadlessSettings, esc.(headless_args)...)))
+            end
+        end)
+
         # Set up timing.
         $loop_var.last_frame_time_ns = time_ns()
         $loop_var.delta_seconds = zero(Float32)
@@ -118,47 +442,31 @@ macro game_loop(block)
 
         # Run the loop.
         $(esc(setup_code))
-        while true
-            GLFW.PollEvents()
-
-            # Update/render.
-            service_Input_update()
-            service_GUI_start_frame()
-            $(esc(loop_code))
-            service_GUI_end_frame()
-            GLFW.SwapBuffers($loop_var.context.window)
-
-            # Advance the timer.
-            $loop_var.frame_idx += 1
-            new_time::UInt = time_ns()
-            $loop_var.delta_seconds = Float32((new_time - $loop_var.last_frame_time_ns) / 1e9)
-            # Cap the framerate, by waiting if necessary.
-            if exists($loop_var.max_fps)
-                wait_time = (1/$loop_var.max_fps) - $loop_var.delta_seconds
-                if wait_time > 0
-                    sleep(wait_time)
-                    # Update the timestamp again after waiting.
-                    new_time = time_ns()
-                    $loop_var.delta_seconds = Float32((new_time - $loop_var.last_frame_time_ns) / 1e9)
-                end
+        try
+            $expr_main_loop
+        finally
+            # Stop the pipeline's worker even if the loop threw.
+            if exists($loop_var.pipeline)
+                close($loop_var.pipeline)
             end
-            $loop_var.last_frame_time_ns = new_time
-            # Cap the length of the next frame.
-            $loop_var.delta_seconds = min(Float32($loop_var.max_frame_duration),
-                                            $loop_var.delta_seconds)
+        end
+        if exists($loop_var.headless)
+            game_loop_end_headless!($loop_var)
         end
         $(esc(teardown_code))
     end )
 
     # Wrap the game in a lambda in case users invoke it globally.
     # Global code is very slow in Julia.
-    return :( (() ->
+    return :( (() -> begin
+        $(if exists(headless_args)
+            :( GLFW.WindowHint(GLFW.VISIBLE, false) )
+        end)
         $(Expr(:call, bp_gl_context,
             do_body,
             esc.(init_args)...
-    )))() )
+        ))
+    end)() )
 end
 
-export @game_loop
-
-#TODO: Fixed-update increments for physics-like stuff
\ No newline at end of file
+export @game_loop
\ No newline at end of file
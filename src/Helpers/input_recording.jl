@@ -0,0 +1,37 @@
+const InputRecordingFrame = Dict{String, Union{Bool, Float32}}
+
+"
+The value of every named button and axis in the Input service, for a sequence of frames.
+Record it during normal play, save it to disk, then replay it later
+    (e.x. for reproducible benchmarks with `@game_loop`'s `HEADLESS` mode).
+"
+struct InputRecording
+    frames::Vector{InputRecordingFrame}
+end
+InputRecording() = InputRecording(InputRecordingFrame[ ])
+export InputRecording
+
+"Records the current state of the Input service as a new frame"
+record_input_frame!(r::InputRecording) = push!(r.frames, get_all_inputs())
+
+"
+Forces the Input service to use the values from the given frame of a recording (1-based).
+If the frame is past the end of the recording, the overrides are cleared and `false` is returned.
+"
+function replay_input_frame(r::InputRecording, frame_idx::Int)::Bool
+    clear_input_overrides()
+    if frame_idx in 1:length(r.frames)
+        for (name, value) in r.frames[frame_idx]
+            set_input_override(name, value)
+        end
+        return true
+    else
+        return false
+    end
+end
+
+save_input_recording(path::AbstractString, r::InputRecording) = write_binary(path, r.frames)
+load_input_recording(path::AbstractString) = InputRecording(read_binary(path, Vector{InputRecordingFrame}))
+
+export record_input_frame!, replay_input_frame,
+       save_input_recording, load_input_recording
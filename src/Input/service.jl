@@ -6,6 +6,10 @@
     current_scroll_pos::v2f
     context_window::GLFW.Window
 
+    # Input values which are forced to something, ignoring the actual devices.
+    # Used to replay recorded input.
+    overrides::Dict{String, Union{Bool, Float32}}
+
     scroll_callback::Base.Callable
 
 
@@ -17,6 +21,7 @@
             Dict{String, AxisInput}(),
             zero(v2f),
             context.window,
+            Dict{String, Union{Bool, Float32}}(),
             _ -> nothing # Dummy callable, real one is below
         )
         service.scroll_callback = (delta::v2f -> (service.current_scroll_pos += delta))
@@ -111,7 +116,9 @@
 
     "Gets the current value of a button. Throws an error if it doesn't exist."
     function get_button(service, name::AbstractString)::Bool
-        if haskey(service.buttons, name)
+        if haskey(service.overrides, name) && haskey(service.buttons, name)
+            return service.overrides[name]::Bool
+        elseif haskey(service.buttons, name)
             return any(b -> b.value, service.buttons[name])
         else
             error("No button named '", name, "'")
@@ -119,7 +126,9 @@
     end
     "Gets the current value of an axis. Throws an error if it doesn't exist."
     function get_axis(service, name::AbstractString)::Float32
-        if haskey(service.axes, name)
+        if haskey(service.overrides, name) && haskey(service.axes, name)
+            return service.overrides[name]::Float32
+        elseif haskey(service.axes, name)
             return service.axes[name].value
         else
             error("No axis named '", name, "'")
@@ -127,7 +136,9 @@
     end
     "Gets the current value of a button or axis. Returns `nothing` if it doesn't exist."
     function get_input(service, name::AbstractString)::Union{Bool, Float32, Nothing}
-        if haskey(service.buttons, name)
+        if haskey(service.overrides, name) && (haskey(service.buttons, name) || haskey(service.axes, name))
+            return service.overrides[name]
+        elseif haskey(service.buttons, name)
             return any(b -> b.value, service.buttons[name])
         elseif haskey(service.axes, name)
             return service.axes[name].value
@@ -136,6 +147,29 @@
         end
     end
 
+    "Gets the current value of every button and axis, keyed by name"
+    function get_all_inputs(service)::Dict{String, Union{Bool, Float32}}
+        values = Dict{String, Union{Bool, Float32}}()
+        for name in Iterators.flatten((keys(service.buttons), keys(service.axes)))
+            values[name] = get_input(service, name)
+        end
+        return values
+    end
+
+    "
+    Forces a button or axis to have a specific value, ignoring the actual devices.
+    Useful for replaying recorded input.
+    "
+    function set_input_override(service, name::AbstractString, value::Union{Bool, Real})
+        service.overrides[name] = (value isa Bool) ? value : convert(Float32, value)
+        return nothing
+    end
+    "Stops forcing the value of any buttons or axes"
+    function clear_input_overrides(service)
+        empty!(service.overrides)
+        return nothing
+    end
+
     "
     Gets the source list of button inputs for a named button.
     You can modify this list at will to reconfigure the button.
@@ -155,4 +189,5 @@ export Service_Input, service_Input_init, service_Input_shutdown,
        create_button, create_axis,
        remove_button, remove_axis,
        get_input, get_button, get_axis,
-       get_button_inputs
\ No newline at end of file
+       get_button_inputs, get_all_inputs,
+       set_input_override, clear_input_overrides
\ No newline at end of file
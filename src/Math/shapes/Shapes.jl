@@ -104,5 +104,6 @@ include("sphere.jl")
 include("capsule.jl")
 include("plane.jl")
 include("triangle.jl")
+include("frustum.jl")
 
 include("collision.jl")
\ No newline at end of file
@@ -0,0 +1,92 @@
+"
+A 3D view frustum, stored as 6 planes which face inwards.
+Each plane is a `Vec4` of `(normal.x, normal.y, normal.z, d)`,
+    where a point `p` is on the inner side if `vdot(normal, p) + d >= 0`.
+The planes are in the order: left, right, bottom, top, near, far.
+"
+struct Frustum{F<:AbstractFloat}
+    planes::NTuple{6, Vec4{F}}
+end
+export Frustum
+
+"
+Extracts the frustum from a combined view-projection matrix
+    (or just a projection matrix, to get the frustum in view space).
+Assumes OpenGL's clip space, where Z goes from -1 to +1.
+"
+function Frustum(view_projection::Mat{4, 4, F})::Frustum{F} where {F}
+    # Reference: Gribb & Hartmann, "Fast Extraction of Viewing Frustum Planes from the World-View-Projection Matrix".
+    m = view_projection
+    row(i) = Vec(c -> m[i, c], Val(4))
+    normalized(plane::Vec4{F}) = plane / vlength(plane.xyz)
+    return Frustum{F}((
+        normalized(row(4) + row(1)),
+        normalized(row(4) - row(1)),
+        normalized(row(4) + row(2)),
+        normalized(row(4) - row(2)),
+        normalized(row(4) + row(3)),
+        normalized(row(4) - row(3))
+    ))
+end
+
+"
+Computes the 8 corners of a frustum, given the inverse of its view-projection matrix.
+They're ordered like the corners of a Box, from the NDC cube's min corner to its max corner.
+"
+function frustum_corners(inv_view_projection::Mat{4, 4, F})::NTuple{8, Vec3{F}} where {F}
+    ndc_corners = Tuple(Vec{3, F}(x, y, z) for z in (-1, 1) for y in (-1, 1) for x in (-1, 1))
+    return map(p -> convert(Vec3{F}, m_apply_point(inv_view_projection, p)),
+               ndc_corners)
+end
+
+export frustum_corners
+
+
+"
+Checks whether a box is at least partially inside the frustum.
+This test is conservative: some boxes just outside the frustum's corners are reported as colliding.
+"
+function collides(f::Frustum{F}, b::Box{3, F})::Bool where {F}
+    b_min = min_inclusive(b)
+    b_max = max_exclusive(b)
+    for plane in f.planes
+        # Test the box corner that is furthest along the plane's normal.
+        furthest = Vec(i -> (plane[i] >= 0) ? b_max[i] : b_min[i], Val(3))
+        if vdot(plane.xyz, furthest) + plane.w < 0
+            return false
+        end
+    end
+    return true
+end
+"Checks whether a sphere is at least partially inside the frustum (conservatively, like for Boxes)"
+function collides(f::Frustum{F}, s::Sphere{3, F})::Bool where {F}
+    for plane in f.planes
+        if vdot(plane.xyz, s.center) + plane.w < -s.radius
+            return false
+        end
+    end
+    return true
+end
+collides(b::Box{3}, f::Frustum) = collides(f, b)
+collides(s::Sphere{3}, f::Frustum) = collides(f, s)
+
+"
+Tests many shapes against a frustum at once,
+    writing `true` into `output` for each one that's at least partially inside it.
+Returns the number of shapes inside the frustum.
+"
+function collides_each!(output::AbstractVector{Bool},
+                        f::Frustum,
+                        shapes::AbstractVector{<:Union{Box{3}, Sphere{3}}}
+                       )::Int
+    @bp_math_assert(length(output) == length(shapes),
+                    "Output has ", length(output), " elements but there are ", length(shapes), " shapes")
+    n_inside::Int = 0
+    for i in eachindex(output, shapes)
+        output[i] = collides(f, shapes[i])
+        n_inside += output[i]
+    end
+    return n_inside
+end
+
+export collides_each!
@@ -1,11 +1,13 @@
 module Utilities
 
-using StaticArrays, MacroTools, Dates, StructTypes, BitFlags
+using StaticArrays, MacroTools, Dates, StructTypes, BitFlags, Mmap
 
 include("asserts.jl")
 @make_toggleable_asserts bp_utils_
 
 include("basic.jl")
+@decentralized_module_init
+
 include("numbers.jl")
 include("unions.jl")
 include("macros.jl")
@@ -14,6 +16,11 @@ include("strings.jl")
 include("enums.jl")
 
 include("up_to.jl")
+include("queues.jl")
+include("jobs.jl")
+include("profiling.jl")
+include("binary_serialization.jl")
+include("memory_tracking.jl")
 
 include("prng.jl")
 include("rand_iterator.jl")
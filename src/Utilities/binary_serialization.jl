@@ -0,0 +1,297 @@
+# A compact binary alternative to JSON for anything that can be serialized through StructTypes.
+# The format is positional: values are written in the order of their fields,
+#    with no names or type info, except for tags on unions.
+
+"
+Wraps an `IO` for `write_binary()`, counting the bytes written
+    so that array data can be aligned relative to the start of the stream.
+"
+mutable struct BinaryWriter{TIO<:IO}
+    io::TIO
+    n_bytes::Int
+end
+BinaryWriter(io::IO) = BinaryWriter(io, 0)
+
+"
+Reads data written with `write_binary()` from a contiguous block of bytes,
+    for example a file loaded with `read()` or memory-mapped with `Mmap.mmap()`.
+
+If `zero_copy` is true, values read as an `AbstractVector{T}` of isbits data are not copied;
+    they're a reinterpreted view of the underlying bytes, which keeps those bytes alive.
+Values read as a `Vector{T}` are always copied.
+"
+mutable struct BinaryReader{TBytes<:AbstractVector{UInt8}}
+    bytes::TBytes
+    position::Int # 0-based
+    zero_copy::Bool
+end
+BinaryReader(bytes::AbstractVector{UInt8}; zero_copy::Bool = false) = BinaryReader(bytes, 0, zero_copy)
+"Memory-maps a file and reads from it."
+BinaryReader(path::AbstractString; zero_copy::Bool = false) = BinaryReader(Mmap.mmap(path), 0, zero_copy)
+
+export BinaryWriter, BinaryReader
+
+
+"
+Writes a value in the compact binary format, and returns the number of bytes written.
+The type `T` determines how the value is written, and must match the type used to read it back.
+For example, a `Union{Int, Nothing}` is written with a tag byte, while an `Int` is not.
+
+* isbits data is written as its raw bytes.
+* Unions (including `SerializedUnion`) are written as a tag byte followed by the value.
+* Strings (and anything else StructTypes treats as a string) are written as a length followed by UTF-8 bytes.
+* Arrays, Sets, and Dicts are written as a length followed by their elements.
+    Vectors of isbits data are written as one aligned block of raw bytes.
+* Structs are written as each of their fields, in order.
+* `StructTypes.CustomStruct` types are written as their `StructTypes.lower()`-ed version.
+"
+write_binary(io::IO, x, T::Type = typeof(x))::Int = write_binary(BinaryWriter(io), x, T)
+write_binary(path::AbstractString, x, T::Type = typeof(x))::Int =
+    open(io -> write_binary(io, x, T), path, "w")
+function write_binary(w::BinaryWriter, x, T::Type = typeof(x))::Int
+    start_n_bytes = w.n_bytes
+    binary_write_value(w, x, T)
+    return w.n_bytes - start_n_bytes
+end
+
+"
+Reads a value of type `T` that was written with `write_binary()`.
+You can read from a `BinaryReader`, a byte buffer, an `IO` stream, or a file path
+    (which is memory-mapped, though arrays are copied; for zero-copy reads use a `BinaryReader`).
+"
+read_binary(r::BinaryReader, T::Type) = binary_read_value(r, T)
+read_binary(bytes::AbstractVector{UInt8}, T::Type) = read_binary(BinaryReader(bytes), T)
+read_binary(io::IO, T::Type) = read_binary(read(io), T)
+read_binary(path::AbstractString, T::Type) = read_binary(BinaryReader(path), T)
+
+export write_binary, read_binary
+
+
+##  Raw data  ##
+
+"Arrays are aligned to at least this many bytes, relative to the start of the stream."
+const BINARY_ARRAY_ALIGNMENT = 16
+
+binary_array_alignment(T::Type) = max(BINARY_ARRAY_ALIGNMENT, Base.datatype_alignment(T))
+"Whether a type is serialized as one raw block of isbits elements (`Vector{E}` or `AbstractVector{E}`)"
+is_binary_bits_vector(T::Type) = (T isa DataType) && (T <: AbstractVector) &&
+                                 isbitstype(eltype(T)) && (Vector{eltype(T)} <: T)
+binary_padding(position::Int, alignment::Int) = mod(-position, alignment)
+
+function binary_write_bytes(w::BinaryWriter, ptr::Ptr, n_bytes::Int)
+    unsafe_write(w.io, ptr, n_bytes)
+    w.n_bytes += n_bytes
+    return nothing
+end
+function binary_write_padding(w::BinaryWriter, alignment::Int)
+    for _ in 1:binary_padding(w.n_bytes, alignment)
+        write(w.io, 0x00)
+        w.n_bytes += 1
+    end
+end
+@inline function binary_write_raw(w::BinaryWriter, x::T) where {T}
+    r = Ref(x)
+    GC.@preserve r binary_write_bytes(w, Base.unsafe_convert(Ptr{T}, r), sizeof(T))
+end
+
+"Lengths and counts are written as variable-length integers (LEB128), as they're usually small."
+function binary_write_length(w::BinaryWriter, n::Integer)
+    @bp_check(n >= 0, "Can't write a negative length: ", n)
+    u = UInt64(n)
+    while u >= 0x80
+        binary_write_raw(w, UInt8(u & 0x7f) | 0x80)
+        u >>= 7
+    end
+    binary_write_raw(w, UInt8(u))
+end
+
+function binary_check_remaining(r::BinaryReader, n_bytes::Int)
+    @bp_check(r.position + n_bytes <= length(r.bytes),
+              "Binary data ended early: needed ", n_bytes, " bytes at position ", r.position,
+                " but only ", length(r.bytes) - r.position, " remain")
+end
+@inline function binary_read_raw(r::BinaryReader, T::Type)
+    binary_check_remaining(r, sizeof(T))
+    value = GC.@preserve r unsafe_load(Ptr{T}(pointer(r.bytes) + r.position))
+    r.position += sizeof(T)
+    return value
+end
+function binary_read_length(r::BinaryReader)::Int
+    u = zero(UInt64)
+    shift = 0
+    while true
+        b = binary_read_raw(r, UInt8)
+        u |= UInt64(b & 0x7f) << shift
+        (b < 0x80) && break
+        shift += 7
+        @bp_check(shift < 64, "Invalid length in binary data")
+    end
+    return Int(u)
+end
+function binary_skip_padding(r::BinaryReader, alignment::Int)
+    n = binary_padding(r.position, alignment)
+    binary_check_remaining(r, n)
+    r.position += n
+end
+
+
+##  Writing values  ##
+
+function binary_write_value(w::BinaryWriter, x, T::Type)
+    if T isa Union
+        return binary_write_union(w, x, T)
+    elseif T <: SerializedUnion
+        return binary_write_union(w, x.data, union_type_param(T))
+    elseif isbitstype(T)
+        return binary_write_raw(w, convert(T, x))
+    end
+
+    st = StructTypes.StructType(T)
+    if st isa StructTypes.CustomStruct
+        return binary_write_value(w, StructTypes.lower(x), StructTypes.lowertype(T))
+    elseif st isa StructTypes.StringType
+        s = string(x)
+        binary_write_length(w, ncodeunits(s))
+        GC.@preserve s binary_write_bytes(w, pointer(s), ncodeunits(s))
+    elseif is_binary_bits_vector(T)
+        E = eltype(T)
+        x_vec = (x isa Vector{E}) ? x : collect(E, x)
+        binary_write_length(w, length(x_vec))
+        binary_write_padding(w, binary_array_alignment(E))
+        GC.@preserve x_vec binary_write_bytes(w, pointer(x_vec), sizeof(E) * length(x_vec))
+    elseif !isconcretetype(T)
+        error("Can't serialize the abstract type ", T, " in binary; ",
+              "use a Union or SerializedUnion of concrete types instead")
+    elseif st isa StructTypes.DictType
+        binary_write_length(w, length(x))
+        (K, V) = (keytype(T), valtype(T))
+        for (k, v) in x
+            binary_write_value(w, k, K)
+            binary_write_value(w, v, V)
+        end
+    elseif T <: Tuple
+        for i in 1:fieldcount(T)
+            binary_write_value(w, x[i], fieldtype(T, i))
+        end
+    elseif st isa StructTypes.ArrayType
+        binary_write_length(w, length(x))
+        E = eltype(T)
+        for element in x
+            binary_write_value(w, element, E)
+        end
+    elseif st isa StructTypes.NullType
+        # Nothing to write.
+    else # Some kind of struct
+        for i in 1:fieldcount(T)
+            binary_write_value(w, getfield(x, i), fieldtype(T, i))
+        end
+    end
+    return nothing
+end
+
+"
+Gets the types in a union, in a stable order for tagging.
+The order of a Union's types isn't guaranteed across Julia versions, so they're sorted by name.
+"
+@generated binary_union_types(::Type{U}) where {U} = Tuple(sort(collect(union_types(U)), by=string))
+union_type_param(::Type{SerializedUnion{U}}) where {U} = U
+
+function binary_write_union(w::BinaryWriter, x, U::Type)
+    types = binary_union_types(U)
+    @bp_check(length(types) <= typemax(UInt8),
+              "Too many types in a union to serialize: ", U)
+    tag = findfirst(T -> x isa T, types)
+    @bp_check(exists(tag), "Value of type ", typeof(x), " isn't part of the union ", U)
+    binary_write_raw(w, UInt8(tag))
+    binary_write_value(w, x, types[tag])
+end
+
+
+##  Reading values  ##
+
+function binary_read_value(r::BinaryReader, T::Type)
+    if T isa Union
+        return binary_read_union(r, T)
+    elseif T <: SerializedUnion
+        return T(binary_read_union(r, union_type_param(T)))
+    elseif isbitstype(T)
+        return binary_read_raw(r, T)
+    end
+
+    st = StructTypes.StructType(T)
+    if st isa StructTypes.CustomStruct
+        return StructTypes.construct(T, binary_read_value(r, StructTypes.lowertype(T)))
+    elseif st isa StructTypes.StringType
+        n = binary_read_length(r)
+        binary_check_remaining(r, n)
+        s = GC.@preserve r unsafe_string(pointer(r.bytes) + r.position, n)
+        r.position += n
+        return (T == String || T == AbstractString) ? s : StructTypes.construct(T, s)
+    elseif is_binary_bits_vector(T)
+        return binary_read_bits_vector(r, eltype(T), !(T <: Vector))
+    elseif !isconcretetype(T)
+        error("Can't deserialize the abstract type ", T, " in binary; ",
+              "use a Union or SerializedUnion of concrete types instead")
+    elseif st isa StructTypes.DictType
+        n = binary_read_length(r)
+        (K, V) = (keytype(T), valtype(T))
+        d = T()
+        sizehint!(d, n)
+        for _ in 1:n
+            k = binary_read_value(r, K)
+            d[k] = binary_read_value(r, V)
+        end
+        return d
+    elseif T <: Tuple
+        return ntuple(i -> binary_read_value(r, fieldtype(T, i)), Val(fieldcount(T)))::T
+    elseif st isa StructTypes.ArrayType
+        n = binary_read_length(r)
+        E = eltype(T)
+        elements = Vector{E}(undef, n)
+        for i in 1:n
+            elements[i] = binary_read_value(r, E)
+        end
+        return (T <: Vector{E}) ? elements : StructTypes.construct(T, elements)
+    elseif st isa StructTypes.NullType
+        return T()
+    elseif st isa StructTypes.Mutable
+        x = T()
+        for i in 1:fieldcount(T)
+            setfield!(x, i, binary_read_value(r, fieldtype(T, i)))
+        end
+        return x
+    else # Some kind of immutable struct
+        fields = ntuple(i -> binary_read_value(r, fieldtype(T, i)), Val(fieldcount(T)))
+        return StructTypes.construct(T, fields...)
+    end
+end
+
+"
+Reads a block of isbits elements.
+If `allow_view` is true and the reader is zero-copy, returns a view of the reader's bytes
+    (which keeps them alive); otherwise returns a copy.
+"
+function binary_read_bits_vector(r::BinaryReader, E::Type, allow_view::Bool)::AbstractVector{E}
+    n = binary_read_length(r)
+    binary_skip_padding(r, binary_array_alignment(E))
+    n_bytes = n * sizeof(E)
+    binary_check_remaining(r, n_bytes)
+
+    byte_range = (r.position + 1):(r.position + n_bytes)
+    r.position += n_bytes
+    if allow_view && r.zero_copy
+        return reinterpret(E, view(r.bytes, byte_range))
+    else
+        output = Vector{E}(undef, n)
+        bytes = r.bytes
+        GC.@preserve bytes unsafe_copyto!(pointer(output), Ptr{E}(pointer(bytes, first(byte_range))), n)
+        return output
+    end
+end
+
+function binary_read_union(r::BinaryReader, U::Type)
+    types = binary_union_types(U)
+    tag = binary_read_raw(r, UInt8)
+    @bp_check(tag in 1:length(types), "Invalid union tag ", Int(tag), " for ", U)
+    return binary_read_value(r, types[tag])
+end
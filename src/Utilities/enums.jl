@@ -17,15 +17,23 @@ export @ano_enum
 """
 An alternative to the @enum macro, with the following differences:
 * Keeps the enum values in a module to prevent name collisions.
-* Provides an overload of `base.parse()` to parse the enum from a string.
-* Provides `MyEnum.from(i::Integer)` to convert from int to enum.
+* Provides an overload of `base.parse()` to parse the enum from a string,
+    and `Base.tryparse()` which returns `nothing` instead of throwing.
+    Parsing uses a switch tree generated at compile-time, so it doesn't allocate
+    and doesn't depend on the number of elements.
+* Provides `MyEnum.from(i::Integer)` to convert from int to enum,
+    and `MyEnum.from(s::Union{AbstractString, Symbol})` to parse from a string or symbol.
 * Provides `MyEnum.from_index(i::Integer)` to get an enum value
     from its index in the original declaration.
 * Provides `MyEnum.to_index(e)` to get the index of an enum value
     in the original declaration.
 * Provides `MyEnum.instances()` to get a tuple of the elements.
+* Provides `MyEnum.to_string(e)` and `MyEnum.to_symbol(e)` to get an element's name
+    from a constant table, without allocating.
 * Provides an alias for the enum type, `E_MyEnum`.
 
+The names of the above functions are reserved, and can't be used as element names.
+
 If you wish to add definitions inside the enum module (e.x. import a package),
   make your own custom macro that returns `generate_enum()`.
   put a `begin ... end` block just after the enum name, containing the desired code.
@@ -59,6 +67,9 @@ Base.contains
 
 #TODO: Bitflag aggregate values should participate in `parse()`, `to_index()`, `from_index()`.
 
+# Names defined inside every enum module, which would collide with an element of the same name.
+const RESERVED_ENUM_NAMES = (:from, :from_index, :to_index, :instances, :to_string, :to_symbol)
+
 """
 The inner logic of @bp_enum.
 Also takes a block of "definitions", in case something needs to be imported into the enum's module.
@@ -109,6 +120,7 @@ function generate_enum(name, definitions, args, is_bitfield::Bool)
     # Thirdly, un-escape the arguments so we can pass them into the @enum call.
     converter_dispatch = Expr(:block)
     args_tuple = Expr(:tuple)
+    arg_names = Symbol[ ]
     args = map(args) do arg
         while Meta.isexpr(arg, :escape)
             arg = arg.args[1]
@@ -121,16 +133,31 @@ function generate_enum(name, definitions, args, is_bitfield::Bool)
         else
             error("Unexpected enum argument: ", arg, "\n\t", sprint(dump, arg))
         end
+        if (arg_name in RESERVED_ENUM_NAMES) || startswith(string(arg_name), "impl_")
+            error("Enum element name '", arg_name, "' is reserved by @bp_enum")
+        end
         arg_symbol_expr = :( Symbol($(string(arg_name))) )
 
         push!(converter_dispatch.args, :(
             $converter_name(::Val{$arg_symbol_expr}) = $arg_name
         ))
         push!(args_tuple.args, arg_name)
+        push!(arg_names, arg_name)
 
         return Meta.isexpr(arg, :escape) ? arg.args[1] : arg
     end
 
+    # Generate a switch tree for parsing names from raw bytes.
+    # Also generate constant tables of the element names.
+    parse_tree = generate_enum_parse_tree(map(string, arg_names), arg_names,
+                                          :impl_bytes_ptr, :impl_bytes_length)
+    names_tuple = Expr(:tuple, map(string, arg_names)...)
+    symbols_tuple = Expr(:tuple, map(QuoteNode, arg_names)...)
+    to_index_chain = Expr(:block)
+    for (i, arg_name) in enumerate(arg_names)
+        push!(to_index_chain.args, :( (e === $arg_name) && return $i ))
+    end
+
     main_macro = is_bitfield ?
                      :( @bitflag $inner_name::$enum_type $(args...) ) :
                      :( @enum $inner_name::$enum_type $(args...) )
@@ -142,19 +169,45 @@ function generate_enum(name, definitions, args, is_bitfield::Bool)
             $main_macro
             $(bitflag_aggregates...)
             $converter_name(i::Integer) = $inner_name(i)
-            $converter_name(s::AbstractString) = $converter_name(Val(Symbol(s)))
+            $converter_name(s::Union{AbstractString, Symbol}) = begin
+                result = impl_try_parse(s)
+                if isnothing(result)
+                    error("Unknown ", $(string(enum_name)), " value: '", s, "'")
+                end
+                return result
+            end
             @inline $index_converter_from_name(i::Integer) = instances()[i]
             @inline $index_converter_to_name(e::$inner_name) = begin
-                for (key, value) in pairs(instances())
-                    if value == e
-                        return key
-                    end
-                end
+                $to_index_chain
                 return nothing
             end
             $converter_dispatch
-            Base.parse(::Type{$inner_name}, s::AbstractString) = $converter_name(Val(Symbol(s)))
-            instances() = $args_tuple
+            Base.parse(::Type{$inner_name}, s::AbstractString) = $converter_name(s)
+            Base.tryparse(::Type{$inner_name}, s::AbstractString) = impl_try_parse(s)
+            $(StructTypes).construct(::Type{$inner_name}, s::Union{AbstractString, Symbol}) = $converter_name(s)
+            @inline instances() = $args_tuple
+
+            # Names are looked up in constant tables rather than generated.
+            # Bitflag combinations which aren't an element fall back to `string()`.
+            @inline to_string(e::$inner_name)::String = let i = $index_converter_to_name(e)
+                isnothing(i) ? string(e) : $names_tuple[i]
+            end
+            @inline to_symbol(e::$inner_name)::Symbol = let i = $index_converter_to_name(e)
+                isnothing(i) ? Symbol(e) : $symbols_tuple[i]
+            end
+
+            # Parsing walks a switch tree over the raw bytes of the name.
+            @inline impl_parse_bytes(impl_bytes_ptr::Ptr{UInt8}, impl_bytes_length::Int)::Union{$inner_name, Nothing} = begin
+                $parse_tree
+            end
+            impl_try_parse(s::Union{String, SubString{String}}) =
+                GC.@preserve s impl_parse_bytes(pointer(s), ncodeunits(s))
+            impl_try_parse(s::AbstractString) = impl_try_parse(String(s))
+            # Symbols are interned forever, so their name data is always safe to read.
+            impl_try_parse(s::Symbol) = impl_parse_bytes(
+                Base.unsafe_convert(Ptr{UInt8}, s),
+                Int(ccall(:strlen, Csize_t, (Ptr{UInt8}, ), s))
+            )
             # Add support for passing an array of enum values into a C function
             #    as if it's an array of the underlying type.
             Base.unsafe_convert(::Type{Ptr{$enum_type}}, r::Ref{$inner_name}) =
@@ -179,4 +232,61 @@ function generate_enum(name, definitions, args, is_bitfield::Bool)
     return output
 end
 
+"
+Generates code that finds which of the given names matches
+    the `length_var` bytes pointed to by `ptr_var`, and evaluates to the corresponding result
+    (or `nothing` if none of them match).
+First it branches on the length of the name, then on whichever byte best splits up the remaining candidates,
+    until only one candidate is left, which is checked with a single `memcmp()`.
+"
+function generate_enum_parse_tree(names::Vector{String}, results::Vector,
+                                  ptr_var::Symbol, length_var::Symbol)
+    # Build an if/elseif chain, where each branch is a (condition, body) pair.
+    function make_branches(branches, fallback)
+        output = fallback
+        for (condition, body) in reverse(branches)
+            output = Expr(:if, condition, body, output)
+        end
+        return output
+    end
+
+    function make_subtree(candidates::Vector{Int}, name_length::Int)
+        if length(candidates) == 1
+            name = names[candidates[1]]
+            result = results[candidates[1]]
+            return :(
+                (ccall(:memcmp, Cint, (Ptr{UInt8}, Ptr{UInt8}, Csize_t),
+                       $ptr_var, $name, $name_length) == 0) ?
+                    $result :
+                    nothing
+            )
+        end
+
+        # Find the byte that splits the candidates into the most groups.
+        best_byte_idx = argmax(1:name_length) do byte_idx
+            length(unique(codeunit(names[c], byte_idx) for c in candidates))
+        end
+        groups = Dict{UInt8, Vector{Int}}()
+        for c in candidates
+            push!(get!(() -> Int[ ], groups, codeunit(names[c], best_byte_idx)), c)
+        end
+        byte_var = gensym(:byte)
+        return quote
+            $byte_var = unsafe_load($ptr_var, $best_byte_idx)
+            $(make_branches([ (:( $byte_var == $b ), make_subtree(groups[b], name_length))
+                              for b in sort(collect(keys(groups))) ],
+                            :nothing))
+        end
+    end
+
+    by_length = Dict{Int, Vector{Int}}()
+    for (i, name) in enumerate(names)
+        push!(get!(() -> Int[ ], by_length, ncodeunits(name)), i)
+    end
+    return make_branches([ (:( $length_var == $n ), make_subtree(by_length[n], n))
+                           for n in sort(collect(keys(by_length))) ],
+                         :nothing)
+end
+
+
 export @bp_enum, @bp_bitflag
\ No newline at end of file
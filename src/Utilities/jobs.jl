@@ -0,0 +1,311 @@
+# A persistent pool of worker threads, running a graph of small jobs.
+# Each worker has its own deque of jobs; it takes from the back of its own deque,
+#    and steals from the front of other workers' deques when it runs dry.
+
+
+"
+Some work to be run by a `JobPool`, plus the jobs that are waiting on it.
+Create one with `add_job!()`, and wait for it with `wait(job)`.
+"
+mutable struct Job
+    const func::Base.Callable
+    const pool::Any # The JobPool that owns this job
+    const lock::Threads.SpinLock
+
+    # The number of unfinished dependencies, plus one while the job is still being set up.
+    @atomic n_blockers::Int
+    dependents::Vector{Job} # Guarded by 'lock'
+
+    @atomic is_finished::Bool
+    # If this job, or one of its dependencies, threw an error.
+    @atomic exception::Optional{CapturedException}
+
+    Job(func, pool) = new(func, pool, Threads.SpinLock(), 1, Job[ ], false, nothing)
+end
+
+is_finished(job::Job) = @atomic job.is_finished
+export Job, is_finished
+
+
+"The jobs queued up for one worker. Its owner uses the back, while other workers steal from the front."
+struct JobDeque
+    lock::Threads.SpinLock
+    jobs::Vector{Job}
+    JobDeque() = new(Threads.SpinLock(), Job[ ])
+end
+
+"How many times an idle worker spins, looking for work, before going to sleep."
+const JOB_WORKER_SPIN_COUNT = 4000
+"How many chunks a parallel-for is split into per worker, by default, to balance the load."
+const PARALLEL_FOR_CHUNKS_PER_WORKER = 4
+
+"
+A persistent set of worker Tasks, running in the default threadpool, that run `Job`s.
+Jobs can depend on other jobs, so you can build up a whole frame's work as a graph
+    (e.x. physics, then transforms, then culling, then uploading)
+    and let the workers chew through it.
+
+By default there is one worker for every thread except the main one.
+The workers aren't pinned to threads; to keep them off of the main (rendering) thread,
+    start Julia with an interactive thread (e.x. `julia -t auto,1`),
+    so that the main thread is in the interactive threadpool.
+Shut it down with `close(pool)`.
+
+* `add_job!(f, pool, dependencies::Job...)` queues up `f()` to run once all `dependencies` are finished.
+* `wait(job)` blocks until a job is finished, helping with other jobs in the meantime.
+    If the job (or any of its dependencies) threw, the error is rethrown here.
+* `add_parallel_for!(f, pool, range, dependencies...)` queues up `f(i)` for each element of `range`,
+     split into chunks, and returns a single Job which finishes when all of them are done.
+* `parallel_for(f, pool, range)` does the same thing and waits for it.
+"
+mutable struct JobPool
+    const deques::Vector{JobDeque}
+    const workers::Vector{Task}
+
+    @atomic is_running::Bool
+    @atomic n_queued::Int
+    @atomic n_sleeping::Int
+    @atomic next_deque::Int # For distributing jobs submitted from outside the pool
+    const sleep_condition::Threads.Condition
+
+    function JobPool(n_workers::Int = max(1, Threads.nthreads() - 1))
+        @bp_check(n_workers > 0, "JobPool needs at least 1 worker")
+        pool = new([ JobDeque() for _ in 1:n_workers ],
+                   Task[ ],
+                   true, 0, 0, 0,
+                   Threads.Condition())
+
+        for worker_idx in 1:n_workers
+            push!(pool.workers, Threads.@spawn :default run_job_worker(pool, worker_idx))
+        end
+
+        return pool
+    end
+end
+export JobPool
+
+function Base.close(pool::JobPool)
+    @atomic pool.is_running = false
+    lock(pool.sleep_condition) do
+        notify(pool.sleep_condition, all=true)
+    end
+    foreach(wait, pool.workers)
+    empty!(pool.workers)
+    return nothing
+end
+
+"
+Gets the index of the worker running in the current task, or 0 if there isn't one.
+Workers can move between threads, so they're identified by their Task.
+"
+@inline function current_job_worker(pool::JobPool)::Int
+    task = current_task()
+    for (i, worker) in enumerate(pool.workers)
+        (worker === task) && return i
+    end
+    return 0
+end
+
+
+"
+Queues up `f()` to run once all the given jobs are finished.
+Returns the new Job, which other jobs can depend on.
+"
+function add_job!(f::Base.Callable, pool::JobPool, dependencies::Job...)::Job
+    job = Job(f, pool)
+    for dependency in dependencies
+        @bp_check(dependency.pool === pool, "Job dependencies must come from the same JobPool")
+        lock(dependency.lock) do
+            if @atomic dependency.is_finished
+                inherit_job_failure!(job, dependency)
+            else
+                @atomic job.n_blockers += 1
+                push!(dependency.dependents, job)
+            end
+        end
+    end
+
+    # Release the job's own 'blocker', now that its dependencies are all hooked up.
+    if (@atomic job.n_blockers -= 1) == 0
+        enqueue_job!(pool, job)
+    end
+    return job
+end
+
+"
+Queues up `f(i)` for every `i` in the given range,
+    split into chunks that are distributed across the workers.
+Returns a Job that finishes once every chunk is done.
+
+By default, the chunk size is picked so each worker gets several chunks to balance the load.
+You can override it with `grain_size`.
+"
+function add_parallel_for!(f::Base.Callable, pool::JobPool, range::AbstractRange,
+                           dependencies::Job...
+                           ;
+                           grain_size::Optional{Int} = nothing
+                          )::Job
+    if isnothing(grain_size)
+        grain_size = max(1, cld(length(range), length(pool.deques) * PARALLEL_FOR_CHUNKS_PER_WORKER))
+    end
+    @bp_check(grain_size > 0, "Parallel-for grain size must be positive: ", grain_size)
+
+    chunk_jobs = map(Iterators.partition(range, grain_size)) do chunk
+        add_job!(pool, dependencies...) do
+            for i in chunk
+                f(i)
+            end
+        end
+    end
+    return add_job!(() -> nothing, pool, chunk_jobs...)
+end
+"
+Runs `f(i)` for every `i` in the given range, in parallel, and waits for them all to finish.
+The calling thread helps out with the work.
+"
+parallel_for(f::Base.Callable, pool::JobPool, range::AbstractRange; kw...) =
+    wait(add_parallel_for!(f, pool, range; kw...))
+
+export add_job!, add_parallel_for!, parallel_for
+
+
+"
+Waits for the given job to finish, running other queued jobs in the meantime.
+Rethrows the job's error, if it had one.
+"
+function Base.wait(job::Job)
+    pool = job.pool::JobPool
+    worker_idx = current_job_worker(pool)
+    while !(@atomic job.is_finished)
+        other_job = find_job!(pool, worker_idx)
+        if exists(other_job)
+            run_job!(pool, other_job)
+        else
+            ccall(:jl_cpu_pause, Cvoid, ())
+            yield()
+        end
+    end
+
+    failure = @atomic job.exception
+    if exists(failure)
+        throw(failure)
+    end
+    return nothing
+end
+
+
+##  Internals  ##
+
+function inherit_job_failure!(job::Job, dependency::Job)
+    failure = @atomic dependency.exception
+    if exists(failure)
+        @atomic job.exception = failure
+    end
+end
+
+function enqueue_job!(pool::JobPool, job::Job)
+    # Prefer the current worker's deque, to keep related jobs on the same core.
+    deque_idx = current_job_worker(pool)
+    if deque_idx == 0
+        deque_idx = 1 + ((@atomic pool.next_deque += 1) % length(pool.deques))
+    end
+    deque = pool.deques[deque_idx]
+    lock(deque.lock) do
+        push!(deque.jobs, job)
+    end
+
+    # Wake up a worker if they're all asleep.
+    # Each side of this handshake first updates its own counter, then reads the other side's,
+    #    so at least one of them will notice the other.
+    @atomic pool.n_queued += 1
+    if (@atomic pool.n_sleeping) > 0
+        lock(pool.sleep_condition) do
+            notify(pool.sleep_condition, all=false)
+        end
+    end
+end
+
+"Grabs the next job for the given worker (or 0 for a non-worker), stealing from other workers if necessary."
+function find_job!(pool::JobPool, worker_idx::Int)::Optional{Job}
+    (@atomic pool.n_queued) < 1 && return nothing
+
+    # Take the most recent job from our own deque.
+    if worker_idx > 0
+        deque = pool.deques[worker_idx]
+        job = lock(deque.lock) do
+            isempty(deque.jobs) ? nothing : pop!(deque.jobs)
+        end
+        if exists(job)
+            @atomic pool.n_queued -= 1
+            return job
+        end
+    end
+
+    # Steal the oldest job from someone else's deque.
+    n_deques = length(pool.deques)
+    for i in 1:n_deques
+        victim_idx = 1 + ((worker_idx + i - 1) % n_deques)
+        (victim_idx == worker_idx) && continue
+        deque = pool.deques[victim_idx]
+        job = lock(deque.lock) do
+            isempty(deque.jobs) ? nothing : popfirst!(deque.jobs)
+        end
+        if exists(job)
+            @atomic pool.n_queued -= 1
+            return job
+        end
+    end
+
+    return nothing
+end
+
+function run_job!(pool::JobPool, job::Job)
+    # If a dependency failed, skip this job and pass the error along.
+    if isnothing(@atomic job.exception)
+        try
+            job.func()
+        catch e
+            @atomic job.exception = CapturedException(e, catch_backtrace())
+        end
+    end
+
+    dependents = lock(job.lock) do
+        @atomic job.is_finished = true
+        d = job.dependents
+        job.dependents = Job[ ]
+        d
+    end
+    for dependent in dependents
+        inherit_job_failure!(dependent, job)
+        if (@atomic dependent.n_blockers -= 1) == 0
+            enqueue_job!(pool, dependent)
+        end
+    end
+end
+
+function run_job_worker(pool::JobPool, worker_idx::Int)
+    n_idle_spins::Int = 0
+    while @atomic pool.is_running
+        job = find_job!(pool, worker_idx)
+        if exists(job)
+            n_idle_spins = 0
+            run_job!(pool, job)
+        elseif n_idle_spins < JOB_WORKER_SPIN_COUNT
+            # Spin for a little while, to keep dispatch latency low.
+            # Yield so that other tasks sharing this thread can still run.
+            n_idle_spins += 1
+            ccall(:jl_cpu_pause, Cvoid, ())
+            yield()
+        else
+            # Go to sleep until more jobs come in.
+            n_idle_spins = 0
+            lock(pool.sleep_condition) do
+                @atomic pool.n_sleeping += 1
+                if (@atomic pool.is_running) && ((@atomic pool.n_queued) < 1)
+                    wait(pool.sleep_condition)
+                end
+                @atomic pool.n_sleeping -= 1
+            end
+        end
+    end
+end
@@ -0,0 +1,154 @@
+# A registry of how much memory each part of the codebase has allocated,
+#    reported through `track_memory!()`/`untrack_memory!()` hooks at the major allocation sites.
+# Useful for memory budgets and leak detection.
+
+
+"""
+The compile-time flag for memory tracking; it's a function that returns the constant `false`.
+Redefine it to return `true` to enable tracking:
+
+````
+@inline Bplus.Utilities.bp_memory_tracking_enabled() = true
+````
+
+When it's `false`, the tracking hooks disappear entirely.
+Enable it before creating any tracked objects, otherwise their eventual release
+    will be subtracted from memory that was never counted.
+"""
+@inline bp_memory_tracking_enabled() = false
+export bp_memory_tracking_enabled
+
+
+"The live counters for one category of memory"
+mutable struct MemoryCategory
+    @atomic live_bytes::Int
+    @atomic live_count::Int
+    @atomic peak_bytes::Int
+    @atomic total_count::Int # Including released objects
+    @atomic budget_bytes::Int
+    MemoryCategory() = new(0, 0, 0, 0, typemax(Int))
+end
+
+"A snapshot of the memory used by one category"
+struct MemoryUsage
+    live_bytes::Int
+    live_count::Int
+    peak_bytes::Int
+    total_count::Int
+    budget_bytes::Optional{Int}
+end
+is_over_budget(u::MemoryUsage) = exists(u.budget_bytes) && (u.live_bytes > u.budget_bytes)
+Base.show(io::IO, u::MemoryUsage) = print(io,
+    "MemoryUsage<", Base.format_bytes(u.live_bytes), " in ", u.live_count, " objects",
+    " (peak ", Base.format_bytes(u.peak_bytes), ")",
+    exists(u.budget_bytes) ? " of $(Base.format_bytes(u.budget_bytes))" : "",
+    ">"
+)
+export MemoryUsage, is_over_budget
+
+# Categories are created on demand, and never removed.
+# The lookup table is copy-on-write: readers grab the current Dict without locking,
+#    and registering a new category publishes a modified copy.
+mutable struct MemoryCategoryTable
+    @atomic categories::Dict{Symbol, MemoryCategory}
+end
+const MEMORY_CATEGORIES = MemoryCategoryTable(Dict{Symbol, MemoryCategory}())
+const MEMORY_CATEGORIES_LOCK = Threads.SpinLock()
+
+@inline function get_memory_category(name::Symbol)::MemoryCategory
+    c = get((@atomic :acquire MEMORY_CATEGORIES.categories), name, nothing)
+    return exists(c) ? c : register_memory_category(name)
+end
+@noinline function register_memory_category(name::Symbol)::MemoryCategory
+    lock(MEMORY_CATEGORIES_LOCK) do
+        # Another thread may have registered it while we waited for the lock.
+        categories = @atomic :acquire MEMORY_CATEGORIES.categories
+        if haskey(categories, name)
+            return categories[name]
+        end
+        c = MemoryCategory()
+        new_categories = copy(categories)
+        new_categories[name] = c
+        @atomic :release MEMORY_CATEGORIES.categories = new_categories
+        return c
+    end
+end
+
+
+"
+Records that an object of the given size was allocated, in the given category.
+B+ uses the categories `:gl_buffers`, `:gl_textures`, `:gl_target_buffers`,
+    `:file_cacher`, `:ecs_components`, and `:fields_outputs`;
+    you can add your own just by using them.
+Does nothing unless `bp_memory_tracking_enabled()`.
+"
+@inline function track_memory!(category::Symbol, n_bytes::Integer)
+    if bp_memory_tracking_enabled()
+        impl_track_memory!(get_memory_category(category), Int(n_bytes))
+    end
+    return nothing
+end
+"
+Records that an object of the given size was released, in the given category.
+Does nothing unless `bp_memory_tracking_enabled()`.
+"
+@inline function untrack_memory!(category::Symbol, n_bytes::Integer)
+    if bp_memory_tracking_enabled()
+        c = get_memory_category(category)
+        @atomic c.live_bytes -= Int(n_bytes)
+        @atomic c.live_count -= 1
+    end
+    return nothing
+end
+export track_memory!, untrack_memory!
+
+function impl_track_memory!(c::MemoryCategory, n_bytes::Int)
+    new_bytes = (@atomic c.live_bytes += n_bytes)
+    @atomic c.live_count += 1
+    @atomic c.total_count += 1
+    @atomic c.peak_bytes max new_bytes
+    return nothing
+end
+
+
+"Sets a byte budget for a category, or removes it if given `nothing`."
+function set_memory_budget!(category::Symbol, n_bytes::Optional{Integer})
+    c = get_memory_category(category)
+    @atomic c.budget_bytes = isnothing(n_bytes) ? typemax(Int) : Int(n_bytes)
+    return nothing
+end
+
+"Gets the memory used by one category, or by every known category as a Dict"
+function memory_usage(category::Symbol)::MemoryUsage
+    c = get_memory_category(category)
+    budget = @atomic c.budget_bytes
+    return MemoryUsage(
+        (@atomic c.live_bytes), (@atomic c.live_count),
+        (@atomic c.peak_bytes), (@atomic c.total_count),
+        (budget == typemax(Int)) ? nothing : budget
+    )
+end
+function memory_usage()::Dict{Symbol, MemoryUsage}
+    categories = @atomic :acquire MEMORY_CATEGORIES.categories
+    return Dict(name => memory_usage(name) for name in keys(categories))
+end
+
+"Gets the categories which are over their budget"
+memory_over_budget()::Vector{Symbol} = [ name for (name, u) in memory_usage() if is_over_budget(u) ]
+
+"
+Resets every category's counters (but not budgets).
+Objects that are still alive will make the counters go negative when they're released,
+    so only do this when nothing tracked is alive.
+"
+function clear_memory_tracking!()
+    for c in values(@atomic :acquire MEMORY_CATEGORIES.categories)
+        @atomic c.live_bytes = 0
+        @atomic c.live_count = 0
+        @atomic c.peak_bytes = 0
+        @atomic c.total_count = 0
+    end
+    return nothing
+end
+
+export set_memory_budget!, memory_usage, memory_over_budget, clear_memory_tracking!
@@ -0,0 +1,182 @@
+# A lightweight zone profiler: `@bp_profile "name" begin ... end` records when a block of code started and ended.
+# Zones are recorded into per-thread ring buffers, and can be exported as a Chrome trace
+#    (viewable in chrome://tracing or https://ui.perfetto.dev).
+
+
+"""
+The compile-time flag for `@bp_profile`; it's a function that returns the constant `false`.
+Redefine it to return `true` to enable profiling:
+
+````
+@inline Bplus.Utilities.bp_profiling_enabled() = true
+````
+
+Like the asserts generated by `@make_toggleable_asserts`,
+    Julia will recompile every zone when this changes,
+    and when it's `false` the zones disappear entirely.
+"""
+@inline bp_profiling_enabled() = false
+export bp_profiling_enabled
+
+
+"A single recorded profiler zone"
+struct ProfileZone
+    name::Ptr{UInt8} # Symbol names are interned forever, so this pointer is always valid
+    thread_id::Int
+    start_ns::UInt64
+    end_ns::UInt64
+end
+profile_zone_name(z::ProfileZone)::String = unsafe_string(z.name)
+profile_zone_seconds(z::ProfileZone)::Float64 = (z.end_ns - z.start_ns) / 1e9
+export ProfileZone, profile_zone_name, profile_zone_seconds
+
+"
+A ring buffer of the most recent zones from one thread.
+Only that thread writes to it, so the only synchronization needed is on the write counter.
+"
+mutable struct ProfileBuffer
+    const zones::Vector{ProfileZone}
+    const mask::Int
+    @atomic write_idx::Int
+    ProfileBuffer(capacity::Int) = new(Vector{ProfileZone}(undef, capacity), capacity - 1, 0)
+end
+
+"How many zones each thread remembers; older ones get overwritten."
+const PROFILE_BUFFER_CAPACITY = 2^16
+
+# One slot per thread, sized when the module loads as the thread count isn't known until then.
+# Each thread's buffer is only allocated when it records its first zone,
+#    so nothing is allocated unless profiling is enabled.
+const PROFILE_BUFFERS = Vector{Optional{ProfileBuffer}}()
+push!(RUN_ON_INIT, () -> begin
+    empty!(PROFILE_BUFFERS)
+    append!(PROFILE_BUFFERS, Iterators.repeated(nothing, Threads.maxthreadid()))
+end)
+
+
+"""
+Profiles a block of code, if `bp_profiling_enabled()`:
+
+````
+@bp_profile "physics" begin
+    step_physics(world)
+end
+````
+
+It can also wrap a whole function definition, profiling every call to it
+    without re-indenting the function's body:
+
+````
+"Steps the physics simulation"
+@bp_profile "physics" function step_physics(world)
+    ...
+end
+````
+
+The zone's name must be a string literal.
+Early `return`s and exceptions inside the block still end the zone properly.
+Like a `try` block, new variables inside the block are local to it.
+"""
+macro bp_profile(name::AbstractString, body)
+    # Function definitions get their body profiled.
+    if function_wrapping_is_valid(body)
+        func_data = SplitDef(body)
+        func_data.body = Expr(:macrocall, GlobalRef(@__MODULE__, Symbol("@bp_profile")), __source__,
+                              name, func_data.body)
+        return esc(:( Core.@__doc__ $(combinedef(func_data)) ))
+    end
+
+    name_symbol = QuoteNode(Symbol(name))
+    return quote
+        if $bp_profiling_enabled()
+            local zone_start_ns::UInt64 = time_ns()
+            try
+                $(esc(body))
+            finally
+                $record_profile_zone($name_symbol, zone_start_ns)
+            end
+        else
+            let
+                $(esc(body))
+            end
+        end
+    end
+end
+export @bp_profile
+
+@inline function record_profile_zone(name::Symbol, start_ns::UInt64)
+    end_ns = time_ns()
+    thread_id = Threads.threadid()
+    if thread_id > length(PROFILE_BUFFERS) # Threads adopted after startup aren't profiled
+        return nothing
+    end
+
+    buffer = @inbounds PROFILE_BUFFERS[thread_id]
+    if isnothing(buffer)
+        buffer = ProfileBuffer(PROFILE_BUFFER_CAPACITY)
+        @inbounds PROFILE_BUFFERS[thread_id] = buffer
+    end
+    idx = @atomic :monotonic buffer.write_idx
+    @inbounds buffer.zones[(idx & buffer.mask) + 1] = ProfileZone(
+        Base.unsafe_convert(Ptr{UInt8}, name),
+        thread_id, start_ns, end_ns
+    )
+    @atomic :release buffer.write_idx = idx + 1
+    return nothing
+end
+
+
+"
+Gets all recorded zones from all threads, ordered by their start time.
+For exact results, make sure no zones are being recorded while this runs.
+"
+function profile_zones()::Vector{ProfileZone}
+    output = ProfileZone[ ]
+    for buffer in PROFILE_BUFFERS
+        isnothing(buffer) && continue
+        n_written = @atomic :acquire buffer.write_idx
+        n_kept = min(n_written, length(buffer.zones))
+        for idx in (n_written - n_kept) : (n_written - 1)
+            push!(output, buffer.zones[(idx & buffer.mask) + 1])
+        end
+    end
+    # If two zones start at the same time, the outer one (which ends later) goes first.
+    sort!(output, by=(z -> (z.start_ns, typemax(UInt64) - z.end_ns)))
+    return output
+end
+"Forgets all recorded zones."
+function clear_profile!()
+    for buffer in PROFILE_BUFFERS
+        if exists(buffer)
+            @atomic :release buffer.write_idx = 0
+        end
+    end
+    return nothing
+end
+
+"
+Writes all recorded zones in the Chrome trace JSON format,
+    which can be viewed in chrome://tracing or https://ui.perfetto.dev.
+"
+function export_chrome_trace(io::IO, zones::Vector{ProfileZone} = profile_zones())
+    # Timestamps are in microseconds, relative to the first zone.
+    t0::UInt64 = isempty(zones) ? zero(UInt64) : minimum(z -> z.start_ns, zones)
+
+    print(io, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[")
+    for (i, zone) in enumerate(zones)
+        (i > 1) && print(io, ',')
+        print(io, "\n{\"name\":\"")
+        escape_string(io, profile_zone_name(zone), "\"")
+        print(io, "\",\"ph\":\"X\",\"pid\":1",
+                  ",\"tid\":", zone.thread_id,
+                  ",\"ts\":", (zone.start_ns - t0) / 1e3,
+                  ",\"dur\":", (zone.end_ns - zone.start_ns) / 1e3,
+                  "}")
+    end
+    print(io, "\n]}\n")
+    return nothing
+end
+export_chrome_trace(path::AbstractString, zones::Vector{ProfileZone} = profile_zones()) =
+    open(io -> export_chrome_trace(io, zones), path, "w")
+
+export profile_zones, clear_profile!, export_chrome_trace
@@ -0,0 +1,323 @@
+# Bounded, lock-free ring-buffer queues for passing work between threads.
+# Unlike `Channel`, pushing and popping never lock and never allocate
+#    (as long as the element type is isbits).
+
+"Rounds a requested queue capacity up to a power of two, so that slot lookup is a bit-mask"
+pow2_queue_capacity(requested::Integer)::Int = Base._nextpow2(max(2, Int(requested)))
+
+
+##   SpscQueue   ##
+
+"
+A bounded queue for exactly one producer thread and exactly one consumer thread.
+Uses nothing but atomic loads/stores on the read and write counters.
+
+The capacity is rounded up to a power of two.
+The element type may not include `Nothing`, as `nothing` is used to signal an empty queue.
+Popped slots are cleared when the element type isn't isbits, so the queue doesn't keep garbage alive.
+
+* `try_push!(q, x)::Bool` adds an element, or returns `false` if the queue is full.
+* `try_pop!(q)::Optional{T}` removes an element, or returns `nothing` if the queue is empty.
+* `try_push_batch!(q, items)::Int` and `try_pop_batch!(q, output)::Int` move many elements at once,
+     paying for the atomic synchronization only once.
+"
+mutable struct SpscQueue{T}
+    # Empty slots hold `nothing`, which is why `T` can't include it.
+    # For isbits `T` this is still stored inline.
+    const buffer::Vector{Union{Nothing, T}}
+    const mask::Int
+
+    # Consumer-owned data.
+    @atomic read_idx::Int
+    cached_write_idx::Int # The consumer's last view of 'write_idx'
+
+    # Keep the producer's counter on a separate cache line from the consumer's.
+    _padding::NTuple{8, Int}
+
+    # Producer-owned data.
+    @atomic write_idx::Int
+    cached_read_idx::Int # The producer's last view of 'read_idx'
+
+    function SpscQueue{T}(capacity::Integer) where {T}
+        @bp_check(!(Nothing <: T), "Queue elements can't include `Nothing`: ", T)
+        cap = pow2_queue_capacity(capacity)
+        return new{T}(fill!(Vector{Union{Nothing, T}}(undef, cap), nothing), cap - 1,
+                      0, 0,
+                      ntuple(i -> 0, Val(8)),
+                      0, 0)
+    end
+end
+export SpscQueue
+
+queue_capacity(q::SpscQueue) = length(q.buffer)
+"The number of elements in the queue; only an estimate if the other thread is working on it"
+Base.length(q::SpscQueue) = clamp((@atomic :acquire q.write_idx) - (@atomic :acquire q.read_idx),
+                                  0, queue_capacity(q))
+Base.isempty(q::SpscQueue) = iszero(length(q))
+Base.eltype(::SpscQueue{T}) where {T} = T
+
+"Adds an element to the queue, returning `false` if there is no room. Only call from the producer thread."
+@inline function try_push!(q::SpscQueue{T}, x)::Bool where {T}
+    w = @atomic :monotonic q.write_idx
+    if (w - q.cached_read_idx) > q.mask
+        q.cached_read_idx = @atomic :acquire q.read_idx
+        if (w - q.cached_read_idx) > q.mask
+            return false
+        end
+    end
+
+    @inbounds q.buffer[(w & q.mask) + 1] = convert(T, x)
+    @atomic :release q.write_idx = w + 1
+    return true
+end
+"Removes the next element from the queue, or returns `nothing` if it's empty. Only call from the consumer thread."
+@inline function try_pop!(q::SpscQueue{T})::Optional{T} where {T}
+    r = @atomic :monotonic q.read_idx
+    if r >= q.cached_write_idx
+        q.cached_write_idx = @atomic :acquire q.write_idx
+        if r >= q.cached_write_idx
+            return nothing
+        end
+    end
+
+    x = spsc_take_value!(q, r)
+    @atomic :release q.read_idx = r + 1
+    return x
+end
+
+"Takes the value out of a readable slot, clearing the slot if it holds a reference"
+@inline function spsc_take_value!(q::SpscQueue{T}, idx::Int)::T where {T}
+    slot = (idx & q.mask) + 1
+    x = @inbounds(q.buffer[slot])::T
+    if !isbitstype(T)
+        @inbounds q.buffer[slot] = nothing
+    end
+    return x
+end
+
+"
+Pushes as many of the given elements as will fit, in order.
+Returns the number that were pushed. Only call from the producer thread.
+"
+function try_push_batch!(q::SpscQueue{T}, items::AbstractVector)::Int where {T}
+    w = @atomic :monotonic q.write_idx
+    q.cached_read_idx = @atomic :acquire q.read_idx
+    n::Int = min(length(items), queue_capacity(q) - (w - q.cached_read_idx))
+
+    for (i, item) in zip(0:(n-1), items)
+        @inbounds q.buffer[((w + i) & q.mask) + 1] = convert(T, item)
+    end
+    @atomic :release q.write_idx = w + n
+    return n
+end
+"
+Pops up to `max_count` elements into the beginning of `output`.
+Returns the number that were popped. Only call from the consumer thread.
+"
+function try_pop_batch!(q::SpscQueue{T}, output::AbstractVector,
+                        max_count::Int = length(output)
+                       )::Int where {T}
+    r = @atomic :monotonic q.read_idx
+    q.cached_write_idx = @atomic :acquire q.write_idx
+    n::Int = min(max_count, q.cached_write_idx - r)
+
+    first_out = firstindex(output)
+    for i in 0:(n-1)
+        @inbounds output[first_out + i] = spsc_take_value!(q, r + i)
+    end
+    @atomic :release q.read_idx = r + n
+    return n
+end
+
+
+##   MpmcQueue   ##
+
+"
+A bounded queue for any number of producer and consumer threads,
+    using Dmitry Vyukov's algorithm (each slot has a sequence number which
+    tells producers and consumers whether it's ready for them).
+Producers and consumers only contend with each other on a single CAS of the write or read counter.
+
+The capacity is rounded up to a power of two.
+The element type may not include `Nothing`, as `nothing` is used to signal an empty queue.
+Popped slots are cleared when the element type isn't isbits, so the queue doesn't keep garbage alive.
+
+Has the same interface as `SpscQueue`.
+"
+mutable struct MpmcQueue{T}
+    # Each slot's sequence number says which 'lap' of the ring it's ready for.
+    # They're only accessed atomically, through `mpmc_sequence()` and `mpmc_sequence!()`.
+    const sequences::Vector{Int}
+    # Empty slots hold `nothing`, which is why `T` can't include it.
+    # For isbits `T` this is still stored inline.
+    const values::Vector{Union{Nothing, T}}
+    const mask::Int
+
+    @atomic read_idx::Int
+    # Keep the producers' counter on a separate cache line from the consumers'.
+    _padding::NTuple{8, Int}
+    @atomic write_idx::Int
+
+    function MpmcQueue{T}(capacity::Integer) where {T}
+        @bp_check(!(Nothing <: T), "Queue elements can't include `Nothing`: ", T)
+        cap = pow2_queue_capacity(capacity)
+        return new{T}(collect(0:(cap-1)), fill!(Vector{Union{Nothing, T}}(undef, cap), nothing),
+                      cap - 1,
+                      0, ntuple(i -> 0, Val(8)), 0)
+    end
+end
+export MpmcQueue
+
+queue_capacity(q::MpmcQueue) = length(q.sequences)
+"The number of elements in the queue; only an estimate if other threads are working on it"
+Base.length(q::MpmcQueue) = clamp((@atomic :acquire q.write_idx) - (@atomic :acquire q.read_idx),
+                                  0, queue_capacity(q))
+Base.isempty(q::MpmcQueue) = iszero(length(q))
+Base.eltype(::MpmcQueue{T}) where {T} = T
+
+# Julia has no atomic operations on array elements, so the sequence numbers are accessed through pointers.
+@inline mpmc_slot(q::MpmcQueue, idx::Int) = (idx & q.mask) + 1
+@inline mpmc_sequence(q::MpmcQueue, idx::Int)::Int = let sequences = q.sequences
+    GC.@preserve sequences Core.Intrinsics.atomic_pointerref(
+        pointer(sequences, mpmc_slot(q, idx)), :acquire
+    )
+end
+@inline mpmc_sequence!(q::MpmcQueue, idx::Int, value::Int) = let sequences = q.sequences
+    GC.@preserve sequences Core.Intrinsics.atomic_pointerset(
+        pointer(sequences, mpmc_slot(q, idx)), value, :release
+    )
+    nothing
+end
+"Takes the value out of a claimed slot, clearing the slot if it holds a reference"
+@inline function mpmc_take_value!(q::MpmcQueue{T}, idx::Int)::T where {T}
+    slot = mpmc_slot(q, idx)
+    x = @inbounds(q.values[slot])::T
+    if !isbitstype(T)
+        @inbounds q.values[slot] = nothing
+    end
+    return x
+end
+
+"Adds an element to the queue, returning `false` if there is no room."
+@inline function try_push!(q::MpmcQueue{T}, x)::Bool where {T}
+    x_t::T = convert(T, x)
+    w = @atomic :monotonic q.write_idx
+    while true
+        diff = mpmc_sequence(q, w) - w
+        if diff == 0
+            # The slot is free; try to claim it.
+            (w_actual, claimed) = @atomicreplace :monotonic :monotonic q.write_idx w => (w + 1)
+            if claimed
+                @inbounds q.values[mpmc_slot(q, w)] = x_t
+                mpmc_sequence!(q, w, w + 1)
+                return true
+            else
+                w = w_actual
+            end
+        elseif diff < 0
+            # The slot still holds an element from the previous lap; the queue is full.
+            return false
+        else
+            # Another producer got here first.
+            w = @atomic :monotonic q.write_idx
+        end
+    end
+end
+"Removes the next element from the queue, or returns `nothing` if it's empty."
+@inline function try_pop!(q::MpmcQueue{T})::Optional{T} where {T}
+    r = @atomic :monotonic q.read_idx
+    while true
+        diff = mpmc_sequence(q, r) - (r + 1)
+        if diff == 0
+            # The slot is filled; try to claim it.
+            (r_actual, claimed) = @atomicreplace :monotonic :monotonic q.read_idx r => (r + 1)
+            if claimed
+                x = mpmc_take_value!(q, r)
+                mpmc_sequence!(q, r, r + q.mask + 1)
+                return x
+            else
+                r = r_actual
+            end
+        elseif diff < 0
+            # The slot hasn't been written yet; the queue is empty.
+            return nothing
+        else
+            # Another consumer got here first.
+            r = @atomic :monotonic q.read_idx
+        end
+    end
+end
+
+"
+Pushes as many of the given elements as will fit, in order.
+The slots are claimed with a single CAS, so the batch is contiguous in the queue.
+Returns the number that were pushed.
+"
+function try_push_batch!(q::MpmcQueue{T}, items::AbstractVector)::Int where {T}
+    n_wanted::Int = length(items)
+    w = @atomic :monotonic q.write_idx
+    while true
+        # Count how many consecutive slots are free for this lap.
+        n::Int = 0
+        while (n < n_wanted) && (mpmc_sequence(q, w + n) == (w + n))
+            n += 1
+        end
+        if n == 0
+            # Either the queue is full, or another producer moved the counter.
+            w_latest = @atomic :monotonic q.write_idx
+            (w_latest == w) && return 0
+            w = w_latest
+            continue
+        end
+
+        (w_actual, claimed) = @atomicreplace :monotonic :monotonic q.write_idx w => (w + n)
+        if claimed
+            for (i, item) in zip(0:(n-1), items)
+                @inbounds q.values[mpmc_slot(q, w + i)] = convert(T, item)
+                mpmc_sequence!(q, w + i, w + i + 1)
+            end
+            return n
+        else
+            w = w_actual
+        end
+    end
+end
+"
+Pops up to `max_count` elements into the beginning of `output`.
+The slots are claimed with a single CAS, so the batch is contiguous in the queue.
+Returns the number that were popped.
+"
+function try_pop_batch!(q::MpmcQueue{T}, output::AbstractVector,
+                        max_count::Int = length(output)
+                       )::Int where {T}
+    r = @atomic :monotonic q.read_idx
+    while true
+        # Count how many consecutive slots are filled for this lap.
+        n::Int = 0
+        while (n < max_count) && (mpmc_sequence(q, r + n) == (r + n + 1))
+            n += 1
+        end
+        if n == 0
+            # Either the queue is empty, or another consumer moved the counter.
+            r_latest = @atomic :monotonic q.read_idx
+            (r_latest == r) && return 0
+            r = r_latest
+            continue
+        end
+
+        (r_actual, claimed) = @atomicreplace :monotonic :monotonic q.read_idx r => (r + n)
+        if claimed
+            first_out = firstindex(output)
+            for i in 0:(n-1)
+                @inbounds output[first_out + i] = mpmc_take_value!(q, r + i)
+                mpmc_sequence!(q, r + i, r + i + q.mask + 1)
+            end
+            return n
+        else
+            r = r_actual
+        end
+    end
+end
+
+
+export queue_capacity, try_push!, try_pop!, try_push_batch!, try_pop_batch!
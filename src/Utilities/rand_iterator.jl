@@ -44,15 +44,20 @@ export RandIterator
 Base.eltype(::RandIterator{I, RNG}) where {I, RNG} = I
 Base.length(it::RandIterator) = it.n
 
-@inline function Base.iterate(it::RandIterator{I, RNG}) where {I, RNG}
-    # Pick the initial index.
+"Picks the (0-based) value where the iteration starts and ends."
+@inline function rand_iterator_start(it::RandIterator{I, RNG})::I where {I, RNG}
     _rand_i = rand(it.rng, one(I):it.n)
     if RNG == ConstPRNG  # Our special immutable RNG
         rand_i = _rand_i[1]
     else
         rand_i = _rand_i
     end
-    first_val = abs(rand_i) % it.n
+    return abs(rand_i) % it.n
+end
+
+@inline function Base.iterate(it::RandIterator{I, RNG}) where {I, RNG}
+    # Pick the initial index.
+    first_val = rand_iterator_start(it)
 
     # Convert from 0-based math to 1-based Julia
     first_val += 1
@@ -82,4 +87,97 @@ end
 
 Base.show(io::IO, it::RandIterator) = print(io,
     "RandIterator<1:", it.n, ">"
-)
\ No newline at end of file
+)
+
+
+"
+One of several disjoint pieces of a `RandIterator`, which can be iterated independently
+   (e.x. on separate threads) without any heap allocations.
+Create them with `RandIteratorPartition(it::RandIterator, i, k)`.
+
+Together, all `k` partitions visit every value in `1:N` exactly once.
+If you iterate through partitions `1` to `k` in order, you get the same sequence as the original iterator.
+"
+struct RandIteratorPartition{I<:Integer}
+    max::I
+    scale::I
+    offset::I
+    n::I
+
+    first_raw_val::I # 0-based, and possibly >= n
+    n_raw_steps::I
+end
+export RandIteratorPartition
+
+"
+Gets the `i`-th of `k` disjoint sub-iterators of the given `RandIterator`.
+
+The underlying sequence is a cycle of `it.max` values (a power of 2 that's at least N),
+   so each partition gets an equal-size piece of that cycle, found by jumping ahead in the sequence.
+The values outside `1:N` are skipped, so each partition visits roughly `N/k` values.
+
+If the iterator uses a mutable RNG, it's copied so that every partition agrees on the starting point.
+"
+@inline function RandIteratorPartition(it::RandIterator{I, RNG}, i::Integer, k::Integer
+                                      )::RandIteratorPartition{I} where {I, RNG}
+    @bp_check(k > 0, "Need at least one partition; got ", k)
+    @bp_check(i in 1:k, "Partition ", i, " doesn't exist; there are ", k)
+
+    start_val::I = if RNG == ConstPRNG
+        rand_iterator_start(it)
+    else
+        rand_iterator_start(RandIterator{I, RNG}(it.max, it.scale, it.offset, copy(it.rng), it.n))
+    end
+
+    first_step = I(div(widen(it.max) * (i - 1), k))
+    last_step = I(div(widen(it.max) * i, k))
+    return RandIteratorPartition{I}(it.max, it.scale, it.offset, it.n,
+                                    rand_iterator_jump(it, start_val, first_step),
+                                    last_step - first_step)
+end
+
+"Advances the underlying (0-based) sequence by many steps at once, in `O(log(n_steps))` time."
+@inline function rand_iterator_jump(it::RandIterator{I}, x::I, n_steps::I)::I where {I}
+    # The max is a power of 2, so a bitmask is the same as a modulo
+    #    (and it stays correct if the multiplication overflows).
+    mask::I = it.max - one(I)
+
+    # Compose the step 'x*scale + offset' with itself by repeated squaring.
+    scale::I = it.scale
+    offset::I = it.offset
+    while n_steps > zero(I)
+        if isodd(n_steps)
+            x = ((x * scale) + offset) & mask
+        end
+        offset = ((offset * scale) + offset) & mask
+        scale = (scale * scale) & mask
+        n_steps >>= 1
+    end
+    return x
+end
+
+
+Base.eltype(::RandIteratorPartition{I}) where {I} = I
+Base.IteratorSize(::Type{<:RandIteratorPartition}) = Base.SizeUnknown()
+
+@inline Base.iterate(it::RandIteratorPartition{I}) where {I} =
+    iterate(it, (it.first_raw_val, it.n_raw_steps))
+@inline function Base.iterate(it::RandIteratorPartition{I}, state::NTuple{2, I}) where {I}
+    (raw_val::I, n_steps_left::I) = state
+    mask::I = it.max - one(I)
+    while n_steps_left > zero(I)
+        val = raw_val
+        raw_val = ((raw_val * it.scale) + it.offset) & mask
+        n_steps_left -= one(I)
+
+        # Convert from 0-based math to 1-based Julia.
+        if val < it.n
+            return (val + one(I), (raw_val, n_steps_left))
+        end
+    end
+    return nothing
+end
+
+Base.show(io::IO, it::RandIteratorPartition) = print(io,
+    "RandIteratorPartition<1:", it.n, ", ", it.n_raw_steps, " steps>"
+)
@@ -52,6 +52,54 @@ function test_buffers()
     @bp_check(buf_actual == [ 0x9, 0x19 ],
               "Copying buffers with offsets: expected [ 0x9, 0x19 ], got ", buf_actual)
 
+    # Try persistent mapping.
+    for map_mode in (BufferMapModes.coherent, BufferMapModes.explicit_flush)
+        buf_mapped = Buffer(4 * sizeof(UInt32), false; map_mode=map_mode, map_readable=true)
+        mapped = get_mapped_array(buf_mapped, UInt32)
+        @bp_check(length(mapped) == 4, map_mode, ": ", length(mapped))
+        mapped .= UInt32[ 5, 6, 7, 8 ]
+        if map_mode == BufferMapModes.explicit_flush
+            flush_mapped_buffer(buf_mapped; byte_offset=0, byte_size=4 * sizeof(UInt32))
+        end
+        buf_actual = get_buffer_data(buf_mapped, UInt32)
+        @bp_check(buf_actual == [ 5, 6, 7, 8 ],
+                  "Writing through a ", map_mode, " mapping: ", buf_actual)
+        @bp_check(get_mapped_array(buf_mapped, UInt32; byte_offset=8, n_elements=1) == [ 7 ])
+        close(buf_mapped)
+        @bp_check(buf_mapped.mapped_ptr == C_NULL)
+    end
+
+    # Try streaming data through a ring of regions.
+    streamer = StreamingBuffer(100; n_regions=3, alignment=64)
+    @bp_check(streamer.region_byte_size == 128, streamer.region_byte_size)
+    for frame in 1:5
+        streaming_begin_frame!(streamer)
+        a1 = streaming_push!(streamer, UInt32(frame))
+        a2 = streaming_push!(streamer, UInt32[ frame, frame*2 ])
+        region_start = (mod1(frame, 3) - 1) * 128
+        @bp_check(min_inclusive(a1.byte_range) == region_start + 1, frame, ": ", a1.byte_range)
+        @bp_check(min_inclusive(a2.byte_range) == region_start + 65, frame, ": ", a2.byte_range)
+        @bp_check(size(a2.byte_range) == 8, a2.byte_range)
+        set_uniform_block(a1, 1)
+        streaming_end_frame!(streamer)
+
+        buf_actual = get_buffer_data(streamer.buffer, UInt32;
+                                     src_byte_offset = region_start + 64,
+                                     src_elements = IntervalU(min=1, size=2))
+        @bp_check(buf_actual == [ frame, frame*2 ], frame, ": ", buf_actual)
+    end
+    set_uniform_block(1)
+    close(streamer)
+    @bp_check(is_destroyed(streamer))
+
+    # Try reading back asynchronously.
+    readback = BufferReadback(16)
+    start_buffer_readback!(readback, buf; src_byte_offset=1, byte_size=3)
+    @bp_check(wait_for_readback(readback))
+    buf_actual = get_readback_data(readback)
+    @bp_check(buf_actual == [ 0x7, 0x9, 0x19 ], buf_actual)
+    close(readback)
+
     # Clean up.
     close(buf2)
     close(buf)
@@ -82,6 +130,22 @@ bp_gl_context( v2i(800, 500), "Running tests...press Enter to finish once render
         check_gl_logs("running test battery")
     end
 
+    # Redundant state changes should be skipped, and counted.
+    reset_state_counters!(context)
+    set_depth_test(context, context.state.depth_test)
+    set_viewport(context, context.state.viewport)
+    @bp_check(context.state_counters.n_render_state_issued == 0, context.state_counters)
+    @bp_check(context.state_counters.n_render_state_skipped == 2, context.state_counters)
+    with_culling(context, (context.state.cull_mode == FaceCullModes.off) ?
+                              FaceCullModes.backwards :
+                              FaceCullModes.off) do
+    end
+    @bp_check(context.state_counters.n_render_state_issued == 2, context.state_counters)
+    last_counters = reset_state_counters!(context)
+    @bp_check(last_counters.n_render_state_skipped == 2, last_counters)
+    @bp_check(context.state_counters.n_render_state_skipped == 0, context.state_counters)
+    check_gl_logs("testing redundant state changes")
+
     # Keep track of the resources to clean up, in the order they should be cleaned up.
     to_clean_up = AbstractResource[ ]
 
@@ -115,6 +179,15 @@ bp_gl_context( v2i(800, 500), "Running tests...press Enter to finish once render
                   count_mesh_elements(mesh_triangles), ")")
     push!(to_clean_up, mesh_triangles, buf_tris_poses, buf_tris_color_and_IDs)
 
+    # Set up indirect draw commands for the same triangles,
+    #    plus a GPU-side count which skips the second (empty) command.
+    buf_tris_indirect = Buffer(false, [
+        DrawArraysIndirectCommand(IntervalU(min=1, size=3)),
+        DrawArraysIndirectCommand(0, 0, 0, 0)
+    ])
+    buf_tris_indirect_count = Buffer(false, GLuint[ 1 ])
+    push!(to_clean_up, buf_tris_indirect, buf_tris_indirect_count)
+
     #TODO: Add another indexed mesh to test indexed rendering.
 
     # Set up a shader to render the triangles.
@@ -278,6 +351,32 @@ bp_gl_context( v2i(800, 500), "Running tests...press Enter to finish once render
     set_depth_test(context, ValueTests.less_than)
     set_blending(context, make_blend_opaque(BlendStateRGBA))
 
+    # Closing the active mesh/program must not leave a stale binding in the Context,
+    #    because the driver may hand the same name to the next new mesh/program.
+    make_temp_triangle_mesh() = Mesh(PrimitiveTypes.triangle,
+                                     [ VertexDataSource(buf_tris_poses, sizeof(v4f)),
+                                       VertexDataSource(buf_tris_color_and_IDs,
+                                                        sizeof(Tuple{vRGBu8, Vec{2, UInt8}}))
+                                     ],
+                                     [ VertexAttribute(1, 0x0, VSInput(v4f)),
+                                       VertexAttribute(2, 0x0, VSInput_FVector(Vec3{UInt8}, true)),
+                                       VertexAttribute(2, sizeof(vRGBu8), VSInput(Vec2{UInt8}))
+                                     ])
+    target_activate(target)
+    view_activate(get_view(tex))
+    temp_mesh = make_temp_triangle_mesh()
+    render_mesh(temp_mesh, draw_triangles)
+    @bp_check(context.active_mesh == temp_mesh.handle)
+    close(temp_mesh)
+    @bp_check(context.active_mesh == GL.Ptr_Mesh(), context.active_mesh)
+    temp_mesh = make_temp_triangle_mesh()
+    render_mesh(temp_mesh, draw_triangles)
+    @bp_check(context.active_mesh == temp_mesh.handle)
+    check_gl_logs("drawing a new mesh after closing the active one")
+    close(temp_mesh)
+    view_deactivate(get_view(tex))
+    target_activate(nothing)
+
     camera_yaw_radians::Float32 = 0
     timer::Int = (GL_TEST_FULL ? 5 : 500) * 60  #Vsync is on, assume 60fps
     while !GLFW.WindowShouldClose(context.window)
@@ -321,6 +420,10 @@ bp_gl_context( v2i(800, 500), "Running tests...press Enter to finish once render
             view_activate(get_view(triangle_tex))
             render_mesh(mesh_triangles, draw_triangles,
                         elements = IntervalU(min=1, size=3))
+            # Draw them again with indirect commands; the depth test hides the duplicates.
+            render_mesh_indirect(mesh_triangles, draw_triangles, buf_tris_indirect)
+            render_mesh_indirect(mesh_triangles, draw_triangles, buf_tris_indirect, 2;
+                                 count_buffer = buf_tris_indirect_count)
             view_deactivate(get_view(triangle_tex))
             check_gl_logs(string("drawing the triangles ", msg_context...))
 
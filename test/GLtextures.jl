@@ -722,4 +722,39 @@ bp_gl_context(v2i(800, 500), "Test: GLtextures") do context::Context
     )
     #TODO: Try copying depth and/or stencil into a color texture
     #TODO: Try copying at different mip levels
+
+    # Upload through a pixel buffer, filling it from another thread.
+    tex_2D_upload = Texture(
+        SimpleFormat(
+            FormatTypes.uint,
+            SimpleFormatComponents.RGBA,
+            SimpleFormatBitDepths.B8
+        ),
+        TEX_SIZE_3D.xy
+    )
+    upload_subset = TexSubset(Box(min=v2u(2, 2), max=v2u(3, 4)))
+    upload = TexUpload(tex_2D_upload, vRGBAu8, upload_subset; recompute_mips=false)
+    @bp_check(size(upload.pixels) == (2, 3), size(upload.pixels))
+    for frame in 1:3
+        wait(Threads.@spawn for I in CartesianIndices(upload.pixels)
+            upload.pixels[I] = vRGBAu8(I[1], I[2], frame, 255)
+        end)
+        start_tex_upload!(upload)
+        @bp_check(wait_for_tex_upload(upload))
+        try_getting_texture(
+            tex_2D_upload, upload_subset,
+            [ vRGBAu8(x, y, frame, 255) for y in 1:3 for x in 1:2 ]
+        )
+    end
+    close(upload)
+    @bp_check(is_destroyed(upload))
+
+    # Read back through a pixel buffer.
+    readback = TexReadback(tex_2D_upload, vRGBAu8, upload_subset)
+    @bp_check(!is_readback_ready(readback))
+    start_tex_readback!(readback)
+    @bp_check(wait_for_readback(readback))
+    @bp_check(get_readback_data(readback) == [ vRGBAu8(x, y, 3, 255) for x in 1:2, y in 1:3 ],
+              get_readback_data(readback))
+    close(readback)
 end
\ No newline at end of file
@@ -0,0 +1,117 @@
+struct BinaryInner
+    name::String
+    values::Vector{Float32}
+end
+Base.:(==)(a::BinaryInner, b::BinaryInner) = (a.name == b.name) && (a.values == b.values)
+StructTypes.StructType(::Type{BinaryInner}) = StructTypes.Struct()
+
+mutable struct BinaryRecord
+    id::Int
+    position::v3f
+    inner::Vector{BinaryInner}
+    tag::@SerializedUnion(Int, String, Nothing)
+    lookup::Dict{String, Vector{Int}}
+    maybe::Optional{v2i}
+    BinaryRecord() = new()
+    BinaryRecord(id, position, inner, tag, lookup, maybe) = new(id, position, inner, tag, lookup, maybe)
+end
+StructTypes.StructType(::Type{BinaryRecord}) = StructTypes.Mutable()
+Base.:(==)(a::BinaryRecord, b::BinaryRecord) = all(getfield(a, f) == getfield(b, f) for f in fieldnames(BinaryRecord))
+
+function binary_round_trip(x, T = typeof(x))
+    io = IOBuffer()
+    n_bytes = write_binary(io, x, T)
+    bytes = take!(io)
+    @bp_check(n_bytes == length(bytes), n_bytes, " vs ", length(bytes))
+    return read_binary(bytes, T)
+end
+
+# Test simple values.
+for x in (5, 3.5f0, v3f(1, 2, 3), (1, 0x2, 3.0), Box((min=v2f(-1, 0), size=v2f(2, 3))),
+          "hello", "", :world, [ 1, 2, 3 ], Int[ ], [ "a", "bc" ],
+          (1, "two", [ 3 ]), Dict(1=>"one", 2=>"two"), Set([ 1, 5, 9 ]))
+    @bp_check(isequal(binary_round_trip(x), x), "Round trip of ", x, " gave ", binary_round_trip(x))
+end
+# isbits data should be written as raw bytes.
+@bp_check(write_binary(IOBuffer(), v3f(1, 2, 3)) == sizeof(v3f))
+
+# Test unions.
+for x in (5, "five", nothing)
+    @bp_check(isequal(binary_round_trip(x, Union{Int, String, Nothing}), x))
+    su = @SerializedUnion(Int, String, Nothing)(x)
+    @bp_check(binary_round_trip(su) == x)
+end
+@bp_check(try
+              write_binary(IOBuffer(), 3.5, Union{Int, String})
+              false
+          catch
+              true
+          end,
+          "Writing a value that isn't part of the union should fail")
+
+# Test a big nested record.
+let r = BinaryRecord(7, v3f(1, 2, 3),
+                     [ BinaryInner("a", Float32[ 1, 2 ]), BinaryInner("b", Float32[ ]) ],
+                     @SerializedUnion(Int, String, Nothing)("tagged"),
+                     Dict("x" => [ 1, 2 ], "y" => Int[ ]),
+                     v2i(4, 5))
+    @bp_check(binary_round_trip(r) == r)
+    r.maybe = nothing
+    r.tag = @SerializedUnion(Int, String, Nothing)(nothing)
+    @bp_check(binary_round_trip(r) == r)
+end
+
+# Test zero-copy reads from a memory-mapped file.
+let path = tempname(),
+    data = [ v4f(i, i+1, i+2, i+3) for i in 1:1000 ],
+    header = "header"
+    open(path, "w") do io
+        w = BinaryWriter(io)
+        write_binary(w, header)
+        write_binary(w, data)
+    end
+
+    reader = BinaryReader(path; zero_copy=true)
+    @bp_check(read_binary(reader, String) == header)
+    mapped = read_binary(reader, AbstractVector{v4f})
+    @bp_check(mapped == data)
+    @bp_check(UInt(pointer(mapped)) % 16 == 0, "Mapped array isn't aligned")
+    @bp_check(pointer(mapped) == pointer(reader.bytes) + reader.position - sizeof(data),
+              "Array was copied instead of mapped")
+    # The view should keep the mapping alive on its own.
+    reader = nothing
+    GC.gc()
+    @bp_check(mapped == data)
+
+    # Reading a concrete Vector always copies.
+    vec_reader = BinaryReader(path; zero_copy=true)
+    read_binary(vec_reader, String)
+    @bp_check(read_binary(vec_reader, Vector{v4f}) isa Vector{v4f})
+    vec_reader = nothing
+
+    # Copying reads should give the same data.
+    copy_reader = BinaryReader(read(path))
+    @bp_check(read_binary(copy_reader, String) == header)
+    copied = read_binary(copy_reader, Vector{v4f})
+    @bp_check(copied == data)
+    @bp_check(pointer(copied) != pointer(copy_reader.bytes) + copy_reader.position - sizeof(data))
+
+    # Release the mapping before deleting the file.
+    mapped = nothing
+    GC.gc()
+    rm(path)
+end
+
+# Test that truncated data fails cleanly.
+let bytes = let io = IOBuffer()
+                write_binary(io, [ 1, 2, 3 ])
+                take!(io)
+            end
+    @bp_check(try
+                  read_binary(bytes[1:end-1], Vector{Int})
+                  false
+              catch
+                  true
+              end,
+              "Reading truncated data should fail")
+end
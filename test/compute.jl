@@ -44,6 +44,67 @@ bp_gl_context( v2i(800, 500), "Compute tests: SSBO",
     "; flexible_mode=false)
     check_gl_logs("After compiling compute1")
     @bp_check(compute1.compute_work_group_size == v3i(8, 8, 1))
+
+    # Compile a program twice through a binary cache; the second time should come from disk.
+    mktempdir() do cache_dir::String
+        cache = ProgramBinaryCache(cache_dir)
+        cached_src = "
+            layout(local_size_x = 4) in;
+            layout(std430) buffer Output { uint values[]; };
+            void main() { values[gl_GlobalInvocationID.x] = gl_GlobalInvocationID.x; }
+        "
+        compiler = ProgramCompiler(cached_src)
+        @bp_check(isnothing(load_program_binary(cache, compiler)),
+                  "Empty cache shouldn't contain anything")
+        cached1 = Program(cached_src; binary_cache=cache, flexible_mode=false)
+        check_gl_logs("After compiling into the binary cache")
+        @bp_check(cached1.compute_work_group_size == v3i(4, 1, 1))
+        # Some drivers don't support any binary formats, in which case nothing is saved.
+        if exists(load_program_binary(cache, compiler))
+            cached2 = Program(cached_src; binary_cache=cache, flexible_mode=false)
+            check_gl_logs("After loading from the binary cache")
+            @bp_check(cached2.compute_work_group_size == v3i(4, 1, 1))
+            close(cached2)
+        end
+        close(cached1)
+    end
+
+    # Compile several programs in the background, collecting them as they finish.
+    async_jobs = map(1:4) do i
+        start_compile_program(ProgramCompiler("
+            layout(local_size_x = $i) in;
+            layout(std430) buffer Output { uint values[]; };
+            void main() { values[gl_GlobalInvocationID.x] = $i; }
+        "))
+    end
+    async_programs = Dict{Int, Program}()
+    while length(async_programs) < length(async_jobs)
+        for (i, job) in enumerate(async_jobs)
+            if !haskey(async_programs, i) && is_compile_done(job)
+                async_programs[i] = Program(job; flexible_mode=false)
+            end
+        end
+    end
+    check_gl_logs("After compiling programs in the background")
+    for (i, program) in async_programs
+        @bp_check(program.compute_work_group_size == v3i(i, 1, 1),
+                  i, ": ", program.compute_work_group_size)
+        close(program)
+    end
+    bad_job = start_compile_program(ProgramCompiler("void main() { this is not GLSL }"))
+    @bp_check(finish_compile_program(bad_job) isa String)
+    @bp_check(compile_program(ProgramCompiler("void main() { this is not GLSL }")) isa String)
+    pull_gl_logs() # Ignore the compile errors, and the background job's failed link
+    # Abandoning a job should clean it up.
+    abandoned_job = start_compile_program(ProgramCompiler("
+        layout(local_size_x = 1) in;
+        void main() { }
+    "))
+    close(abandoned_job)
+    @bp_check(abandoned_job.is_finished)
+    close(abandoned_job)
+    check_gl_logs("After abandoning a program compile job")
+
     #  2. Raise color to an exponent.
     POWERS = Float32.((1.2, 0.4, 1.5, 0.9))
     compute2 = Program("
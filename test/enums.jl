@@ -30,6 +30,17 @@ macro test_enum(E::Symbol, a_val, b_val, c_val)
         @bp_check($E.from("a") == $E.a, $E, " from string")
         @bp_check($E.from("b") == $E.b, $E, " from string")
         @bp_check($E.from("c") == $E.c, $E, " from string")
+
+        @bp_test_no_allocations($E.from(:a), $E.a)
+        @bp_test_no_allocations($E.from(:c), $E.c)
+        @bp_test_no_allocations_setup(s = "xbx", $E.from(SubString(s, 2:2)), $E.b)
+        @bp_test_no_allocations(tryparse($(Symbol(:E_, E)), "d"), nothing)
+        @bp_test_no_allocations(tryparse($(Symbol(:E_, E)), "ab"), nothing)
+        @bp_check(parse($(Symbol(:E_, E)), "c") == $E.c, $E, " from parse()")
+
+        @bp_test_no_allocations($E.to_string($E.a), "a")
+        @bp_test_no_allocations($E.to_string($E.c), "c")
+        @bp_test_no_allocations($E.to_symbol($E.b), :b)
     end
 end
 
@@ -47,6 +58,22 @@ end
 @test_enum A 0 1 2
 @test_enum B 0 20 -10
 
+# Test serialization through StructTypes.
+@bp_check(JSON3.write(B.b) == "\"b\"", JSON3.write(B.b))
+@bp_check(JSON3.read(JSON3.write(B.c), E_B) == B.c)
+@bp_check(JSON3.read(JSON3.write([ A.c, A.a, A.b ]), Vector{E_A}) == [ A.c, A.a, A.b ])
+
+# Names used by the enum module itself can't be elements.
+for bad_name in (:to_string, :to_symbol, :from, :impl_try_parse)
+    @bp_check(try
+                  Bplus.Utilities.generate_enum(:BadEnum, :(begin end), (:a, bad_name), false)
+                  false
+              catch
+                  true
+              end,
+              "Enum element '", bad_name, "' should be rejected")
+end
+
 # Test bitflags.
 @bp_bitflag D a b c
 @test_enum D 1 2 4
@@ -91,4 +118,13 @@ end
 @bp_test_no_allocations(M.D.a, M.D.from(5))
 @bp_test_no_allocations(M.D.b, M.D.from(1))
 @bp_test_no_allocations(M.D.c, M.D.from(-1))
-@bp_test_no_allocations(M.D.d, M.D.from(0))
\ No newline at end of file
+@bp_test_no_allocations(M.D.d, M.D.from(0))
+# Test parsing when many names share a length and prefix, to exercise the whole switch tree.
+@bp_enum G abc abd xbc abcd ab a_b_c
+for g in G.instances()
+    @bp_check(G.from(G.to_string(g)) == g, "Round-tripping ", g, " through a string")
+    @bp_check(G.from(G.to_symbol(g)) == g, "Round-tripping ", g, " through a symbol")
+end
+for bad_name in ("", "abe", "xbd", "abcde", "a", "ABC", "a_b_d")
+    @bp_check(isnothing(tryparse(E_G, bad_name)), "Parsed a bad name: '", bad_name, "'")
+end
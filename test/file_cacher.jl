@@ -97,6 +97,156 @@ try
     found_modifications = check_disk_modifications!(CACHER)
     @bp_check(found_modifications, "Didn't notice deletion of b.json")
     check_equality("b.json", ERROR_CACHED_DATA)
+
+    # Test a cacher that watches for OS notifications instead of polling.
+    watching_cacher = FileCacher{MyCacheableData}(
+        reload_response = (path, old...) -> file_load(path),
+        error_response = (path, ex, trace, old...) -> ERROR_CACHED_DATA,
+        relative_path = TEMP_PATH,
+        watch_files = true
+    )
+    file_update("d.json", MyCacheableData(4, 4.4, [ ]))
+    @bp_check(get_cached_data!(watching_cacher, "d.json") == MyCacheableData(4, 4.4, [ ]))
+    @bp_check(!check_disk_modifications!(watching_cacher),
+              "Watching cacher reported a change when nothing happened")
+    sleep(1.1) # Make sure the file's modified time changes
+    file_update("d.json", MyCacheableData(-4, -4.4, [ ]))
+    found_modifications = false
+    for _ in 1:50 # Notifications come in asynchronously, so give them some time
+        sleep(0.1)
+        found_modifications = check_disk_modifications!(watching_cacher)
+        found_modifications && break
+    end
+    @bp_check(found_modifications, "Watching cacher didn't notice modification to d.json")
+    @bp_check(get_cached_data!(watching_cacher, "d.json") == MyCacheableData(-4, -4.4, [ ]))
+    close(watching_cacher)
+
+    # Test loading files in the background.
+    loaded_paths = String[ ]
+    async_cacher = FileCacher{MyCacheableData}(
+        reload_response = (path, old...) -> file_load(path),
+        error_response = (path, ex, trace, old...) -> ERROR_CACHED_DATA,
+        relative_path = TEMP_PATH,
+        max_concurrent_loads = 2,
+        on_loaded = (path, data) -> push!(loaded_paths, path)
+    )
+    for i in 1:10
+        file_update("async$i.json", MyCacheableData(i, i, [ ]))
+    end
+    prefetch!(async_cacher, ("async$i.json" for i in 1:5))
+    futures = [ get_cached_data(async_cacher, "async$i.json") for i in 1:10 ]
+    @bp_check(futures[1] === get_cached_data(async_cacher, "async1.json"),
+              "Requesting a file that's already loading should give the same future")
+    for i in 1:10
+        check_equality(fetch(futures[i]), MyCacheableData(i, i, [ ]), "Async loading async$i.json")
+    end
+    @bp_check(isempty(loaded_paths), "on_loaded was raised before the loads were finished")
+    @bp_check(finish_cached_loads!(async_cacher) == 10)
+    @bp_check(Set(loaded_paths) == Set(file_full_path("async$i.json") for i in 1:10), loaded_paths)
+    @bp_check(length(async_cacher.files) == 10)
+    # Cached data should come back immediately.
+    @bp_check(fetch(get_cached_data(async_cacher, "async3.json")) == MyCacheableData(3, 3, [ ]))
+    # Missing files should fall back to the error data.
+    check_equality(fetch(get_cached_data(async_cacher, "missing.json")), ERROR_CACHED_DATA,
+                   "Async loading a missing file")
+    close(async_cacher)
+
+    # A background load whose error_response throws shouldn't stop the other loads from finishing.
+    n_error_responses = Threads.Atomic{Int}(0)
+    throwing_cacher = FileCacher{MyCacheableData}(
+        reload_response = (path, old...) -> file_load(path),
+        error_response = (path, ex, trace, old...) -> begin
+            # Throw the first time, from the background load.
+            (Threads.atomic_add!(n_error_responses, 1) == 0) && error("error_response failed")
+            ERROR_CACHED_DATA
+        end,
+        relative_path = TEMP_PATH
+    )
+    bad_future = get_cached_data(throwing_cacher, "missing.json")
+    good_future = get_cached_data(throwing_cacher, "async1.json")
+    @bp_check(isnothing(fetch(bad_future)))
+    wait(good_future)
+    @bp_check(finish_cached_loads!(throwing_cacher) == 2)
+    @bp_check(n_error_responses[] == 2, n_error_responses[])
+    @bp_check(get_cached_data!(throwing_cacher, "async1.json") == MyCacheableData(1, 1, [ ]))
+    check_equality(get_cached_data!(throwing_cacher, "missing.json"), ERROR_CACHED_DATA,
+                   "Fallback data for a load whose error_response threw")
+    close(throwing_cacher)
+
+    # Test a byte budget, evicting the least-recently-used data.
+    closed_paths = String[ ]
+    budget_cacher = FileCacher{MyCacheableData}(
+        reload_response = (path, old...) -> file_load(path),
+        error_response = (path, ex, trace, old...) -> ERROR_CACHED_DATA,
+        relative_path = TEMP_PATH,
+        byte_budget = 300,
+        size_response = data -> 100,
+        close_response = (path, data) -> push!(closed_paths, path)
+    )
+    for i in 1:3
+        get_cached_data!(budget_cacher, "async$i.json")
+    end
+    @bp_check(isempty(closed_paths), closed_paths)
+    get_cached_data!(budget_cacher, "async1.json") # Now async2 is the least-recently-used
+    pin_cached_data!(budget_cacher, "async2.json")
+    get_cached_data!(budget_cacher, "async4.json")
+    @bp_check(closed_paths == [ file_full_path("async3.json") ],
+              "Evicted the wrong data: ", closed_paths)
+    @bp_check(budget_cacher.total_byte_size == 300, budget_cacher.total_byte_size)
+    unpin_cached_data!(budget_cacher, "async2.json")
+    get_cached_data!(budget_cacher, "async5.json")
+    @bp_check(closed_paths == file_full_path.([ "async3.json", "async2.json" ]),
+              "Evicted the wrong data after unpinning: ", closed_paths)
+    @bp_check(Set(keys(budget_cacher.files)) == Set(file_full_path.([ "async1.json", "async4.json", "async5.json" ])),
+              keys(budget_cacher.files))
+    @bp_check((budget_cacher.stats.n_hits, budget_cacher.stats.n_misses, budget_cacher.stats.n_evictions) ==
+                (1, 5, 2),
+              budget_cacher.stats)
+    close(budget_cacher)
+
+    # Test warm starts from an index of processed files.
+    n_reloads = Ref(0)
+    n_artifact_loads = Ref(0)
+    make_indexed_cacher() = FileCacher{MyCacheableData}(
+        reload_response = (path, old...) -> begin
+            n_reloads[] += 1
+            file_load(path)
+        end,
+        error_response = (path, ex, trace, old...) -> ERROR_CACHED_DATA,
+        relative_path = TEMP_PATH,
+        index_path = file_full_path("index/files.bin"),
+        save_artifact_response = (data, artifact_path) -> write_binary(artifact_path, data),
+        load_artifact_response = artifact_path -> begin
+            n_artifact_loads[] += 1
+            read_binary(artifact_path, MyCacheableData)
+        end
+    )
+    file_update("indexed.json", MyCacheableData(5, 5.5, [ ]))
+    let cacher = make_indexed_cacher()
+        check_equality(get_cached_data!(cacher, "indexed.json"), MyCacheableData(5, 5.5, [ ]),
+                       "Cold-loading indexed.json")
+        close(cacher)
+    end
+    @bp_check((n_reloads[], n_artifact_loads[]) == (1, 0), n_reloads[], " / ", n_artifact_loads[])
+    @bp_check(isfile(file_full_path("index/files.bin")), "Index wasn't saved")
+    # The next run should use the processed artifact.
+    let cacher = make_indexed_cacher()
+        check_equality(get_cached_data!(cacher, "indexed.json"), MyCacheableData(5, 5.5, [ ]),
+                       "Warm-loading indexed.json")
+        close(cacher)
+    end
+    @bp_check((n_reloads[], n_artifact_loads[]) == (1, 1), n_reloads[], " / ", n_artifact_loads[])
+    # If the file changes between runs, it should be processed again.
+    file_update("indexed.json", MyCacheableData(-55555, -5.5, [ ]))
+    let cacher = make_indexed_cacher()
+        check_equality(get_cached_data!(cacher, "indexed.json"), MyCacheableData(-55555, -5.5, [ ]),
+                       "Loading changed indexed.json")
+        close(cacher)
+    end
+    @bp_check((n_reloads[], n_artifact_loads[]) == (2, 1), n_reloads[], " / ", n_artifact_loads[])
+    # Different files must never share an artifact.
+    @bp_check(Bplus.Helpers.get_artifact_file_name("a/b.json") !=
+                Bplus.Helpers.get_artifact_file_name("a_b.json"))
 finally
     rm(TEMP_PATH, recursive=true)
 end
\ No newline at end of file
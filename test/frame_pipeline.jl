@@ -0,0 +1,61 @@
+mutable struct PipelineTestState
+    input::Int
+    output::Int
+    frame_idx::Int
+end
+
+# Test that frames come out in order, with their inputs and outputs intact.
+let next_input = Ref(0),
+    pipeline = FramePipeline{PipelineTestState}(
+        (state, frame) -> begin
+            sleep(0.001 * rand()) # Shake up the timing
+            state.output = state.input * 2
+            state.frame_idx = frame.frame_idx
+        end,
+        () -> PipelineTestState(-1, -1, -1),
+        prepare_response = (state, frame) -> (state.input = (next_input[] += 1)),
+        depth = 3
+    )
+    rendered = Tuple{Int, Int, Int}[ ]
+    for i in 1:20
+        pipeline_submit!(pipeline, PipelineFrame(i, 0.1))
+        if pipeline_is_full(pipeline)
+            state = pipeline_take!(pipeline)
+            push!(rendered, (state.frame_idx, state.input, state.output))
+            pipeline_release!(pipeline, state)
+        end
+    end
+    # Drain the frames that are still in flight.
+    while pipeline.n_in_flight > 0
+        state = pipeline_take!(pipeline)
+        push!(rendered, (state.frame_idx, state.input, state.output))
+        pipeline_release!(pipeline, state)
+    end
+    close(pipeline)
+    @bp_check(rendered == [ (i, i, i*2) for i in 1:20 ], rendered)
+end
+
+# Test that errors in the simulation show up on the rendering side.
+let pipeline = FramePipeline{PipelineTestState}(
+        (state, frame) -> (frame.frame_idx == 1) ?
+                              error("Simulation failed") :
+                              (state.frame_idx = frame.frame_idx),
+        () -> PipelineTestState(-1, -1, -1),
+        depth = 1
+    )
+    pipeline_submit!(pipeline, PipelineFrame(1, 0.1))
+    @bp_check(try
+                  pipeline_take!(pipeline)
+                  false
+              catch e
+                  e isa CapturedException
+              end,
+              "Simulation error wasn't passed along")
+    # The failed frame's state buffer should have been given back,
+    #    so the pipeline can keep going after the error is handled.
+    pipeline_submit!(pipeline, PipelineFrame(2, 0.1))
+    state = pipeline_take!(pipeline)
+    @bp_check(state.frame_idx == 2, state)
+    pipeline_release!(pipeline, state)
+    close(pipeline)
+end
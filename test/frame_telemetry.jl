@@ -0,0 +1,66 @@
+function record_test_frame(t::FrameTelemetry, frame_idx::Int)
+    telemetry_begin_frame!(t, frame_idx)
+    for section in (:input, :update, :gui, :update, :swap, :wait)
+        telemetry_mark!(t, section)
+    end
+    telemetry_end_frame!(t)
+    return t.n_recorded
+end
+
+# Test the ring buffer.
+let t = FrameTelemetry(8)
+    @bp_check(telemetry_count(t) == 0)
+    @bp_check(telemetry_summary(t).n_frames == 0)
+    for i in 1:5
+        record_test_frame(t, i)
+    end
+    @bp_check(telemetry_count(t) == 5)
+    @bp_check(map(s -> s.frame_idx, telemetry_samples(t)) == 1:5,
+              collect(telemetry_samples(t)))
+    for i in 6:20
+        record_test_frame(t, i)
+    end
+    @bp_check(telemetry_count(t) == 8)
+    @bp_check(map(s -> s.frame_idx, telemetry_samples(t)) == 13:20,
+              collect(telemetry_samples(t)))
+    @bp_check(all(s -> s.frame_seconds >= s.input_seconds + s.update_seconds + s.gui_seconds,
+                  telemetry_samples(t)))
+
+    summary = telemetry_summary(t)
+    @bp_check(summary.n_frames == 8)
+    @bp_check(summary.low_0_1_percent_seconds == summary.max_frame_seconds)
+    @bp_check(summary.low_1_percent_seconds <= summary.max_frame_seconds)
+
+    csv = sprint(export_telemetry_csv, t)
+    csv_lines = split(strip(csv), '\n')
+    @bp_check(length(csv_lines) == 9, csv)
+    @bp_check(startswith(csv_lines[1], "frame_idx,input_seconds,"), csv_lines[1])
+    @bp_check(startswith(csv_lines[2], "13,"), csv_lines[2])
+
+    json = JSON3.read(sprint(export_telemetry_json, t))
+    @bp_check(json.summary.n_frames == 8, json.summary)
+    @bp_check(map(f -> f.frame_idx, json.frames) == 13:20, json.frames)
+
+    clear_telemetry!(t)
+    @bp_check(telemetry_count(t) == 0)
+end
+
+# The JSON should stay valid with no frames, or with non-finite measurements.
+let t = FrameTelemetry(4)
+    json = JSON3.read(sprint(export_telemetry_json, t))
+    @bp_check(json.summary.n_frames == 0, json.summary)
+    @bp_check(isempty(json.frames), json.frames)
+
+    t.samples[1] = FrameTelemetrySample(1, 0, 0, 0, 0, 0, NaN32, Inf32, 0)
+    t.n_recorded = 1
+    json = JSON3.read(sprint(export_telemetry_json, t))
+    @bp_check(isnothing(json.frames[1].frame_seconds), json.frames[1])
+    @bp_check(isnothing(json.frames[1].gc_seconds), json.frames[1])
+end
+
+# Recording shouldn't allocate.
+let t = FrameTelemetry(4)
+    record_test_frame(t, 1) # Compile it first
+    n_bytes = @allocated record_test_frame(t, 2)
+    @bp_check(n_bytes == 0, "Recording a frame allocated ", Base.format_bytes(n_bytes))
+end
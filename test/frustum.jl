@@ -0,0 +1,60 @@
+# Test frustum culling, using a 3D camera at the origin looking down +Y.
+const TEST_CAM = Cam3D{Float32}(
+    pos = zero(v3f),
+    forward = v3f(0, 1, 0),
+    up = v3f(0, 0, 1),
+    clip_range = Interval{Float32}(min=0.1, max=100),
+    fov_degrees = 90
+)
+const TEST_CAM_CACHE = Cam3D_Cache(TEST_CAM)
+test_box(center) = Box3D{Float32}(center=center, size=one(v3f))
+
+@bp_check(collides(TEST_CAM_CACHE.frustum, test_box(v3f(0, 10, 0))), "Box in front of the camera")
+@bp_check(collides(TEST_CAM_CACHE.frustum, test_box(v3f(9, 10, 9))), "Box near the frustum's corner")
+@bp_check(!collides(TEST_CAM_CACHE.frustum, test_box(v3f(0, -10, 0))), "Box behind the camera")
+@bp_check(!collides(TEST_CAM_CACHE.frustum, test_box(v3f(0, 200, 0))), "Box past the far plane")
+@bp_check(!collides(TEST_CAM_CACHE.frustum, test_box(v3f(30, 10, 0))), "Box off to the side")
+@bp_check(!collides(TEST_CAM_CACHE.frustum, test_box(v3f(0, 10, -30))), "Box below")
+@bp_check(collides(TEST_CAM_CACHE.frustum, Sphere{3, Float32}(v3f(12, 10, 0), 2.5)), "Sphere touching the side")
+@bp_check(!collides(TEST_CAM_CACHE.frustum, Sphere{3, Float32}(v3f(12, 10, 0), 1)), "Sphere off to the side")
+
+let boxes = [ test_box(v3f(x, 10, 0)) for x in -30:3:30 ],
+    results = fill(false, length(boxes))
+    n_inside = collides_each!(results, TEST_CAM_CACHE.frustum, boxes)
+    @bp_check(n_inside == count(results))
+    @bp_check(results == [ abs(x) <= 11 for x in -30:3:30 ], collect(zip(-30:3:30, results)))
+end
+
+# The frustum's corners should lie on the near and far planes.
+@bp_check(all(isapprox(c.y, 0.1f0, atol=0.001) for c in TEST_CAM_CACHE.frustum_corners[1:4]),
+          TEST_CAM_CACHE.frustum_corners)
+@bp_check(all(isapprox(c.y, 100, rtol=0.001) for c in TEST_CAM_CACHE.frustum_corners[5:8]),
+          TEST_CAM_CACHE.frustum_corners)
+
+# Test cascade splits.
+let ranges = cam_cascade_ranges(TEST_CAM, 4)
+    @bp_check(length(ranges) == 4)
+    @bp_check(min_inclusive(ranges[1]) ≈ min_inclusive(TEST_CAM.clip_range), ranges)
+    @bp_check(max_inclusive(ranges[end]) ≈ max_exclusive(TEST_CAM.clip_range), ranges)
+    for i in 2:4
+        @bp_check(max_inclusive(ranges[i-1]) ≈ min_inclusive(ranges[i]),
+                  "Cascades should be contiguous: ", ranges)
+        @bp_check(size(ranges[i]) > size(ranges[i-1]),
+                  "Later cascades should be larger: ", ranges)
+    end
+    cascades = cam_cascades(TEST_CAM, 4)
+    @bp_check(collides(cascades[1].frustum, test_box(v3f(0, 1, 0))))
+    @bp_check(!collides(cascades[4].frustum, test_box(v3f(0, 1, 0))))
+end
+
+# Test screen-space bounds.
+let centered = cam_screen_bounds(TEST_CAM_CACHE, test_box(v3f(0, 10, 0)))
+    @bp_check(isapprox(center(centered), zero(v2f), atol=0.0001), centered)
+    @bp_check(all(size(centered) > 0), centered)
+    # Further boxes should look smaller.
+    far = cam_screen_bounds(TEST_CAM_CACHE, test_box(v3f(0, 50, 0)))
+    @bp_check(all(size(far) < size(centered)), far, " vs ", centered)
+    # Boxes behind the camera can't be bounded.
+    behind = cam_screen_bounds(TEST_CAM_CACHE, test_box(v3f(0, -10, 0)))
+    @bp_check(isapprox(size(behind), v2f(2, 2)), behind)
+end
@@ -0,0 +1,65 @@
+# Test the fixed-update accumulator with a headless game loop.
+# Headless frames use a fixed time step (except the first, which has no time step),
+#    and the times here are exact in binary so there's no rounding near step boundaries.
+let steps_per_frame = Int[ ],
+    n_fixed_updates = Ref(0),
+    accumulators = Float64[ ]
+    @game_loop begin
+        INIT(v2i(100, 100), "Fixed update test")
+        HEADLESS(n_frames = 7, delta_seconds = 0.375)
+        SETUP = begin
+            LOOP.fixed_update_rate = 4 # 0.25 seconds per step
+        end
+        FIXED_UPDATE = begin
+            @bp_check(LOOP.fixed_delta_seconds == 0.25f0, LOOP.fixed_delta_seconds)
+            n_fixed_updates[] += 1
+        end
+        LOOP = begin
+            push!(steps_per_frame, n_fixed_updates[])
+            n_fixed_updates[] = 0
+            push!(accumulators, LOOP.fixed_update_accumulator)
+        end
+    end
+    # 0.375 seconds per frame is 1.5 steps, so the leftover half-step
+    #    carries over and the frames alternate between 1 and 2 steps.
+    @bp_check(steps_per_frame == [ 0, 1, 2, 1, 2, 1, 2 ], steps_per_frame)
+    @bp_check(accumulators == [ 0, 0.125, 0, 0.125, 0, 0.125, 0 ], accumulators)
+end
+
+# Test that a slow frame's extra fixed updates are dropped, rather than piling up.
+let steps_per_frame = Int[ ],
+    n_fixed_updates = Ref(0),
+    n_dropped = Int[ ]
+    @game_loop begin
+        INIT(v2i(100, 100), "Dropped fixed update test")
+        HEADLESS(n_frames = 3, delta_seconds = 2.0)
+        SETUP = begin
+            LOOP.fixed_update_rate = 4
+            LOOP.max_fixed_updates_per_frame = 3
+        end
+        FIXED_UPDATE = (n_fixed_updates[] += 1)
+        LOOP = begin
+            push!(steps_per_frame, n_fixed_updates[])
+            n_fixed_updates[] = 0
+            push!(n_dropped, LOOP.n_dropped_fixed_updates)
+        end
+    end
+    # Each 2-second frame wants 8 steps; 3 are run and 5 are dropped.
+    @bp_check(steps_per_frame == [ 0, 3, 3 ], steps_per_frame)
+    @bp_check(n_dropped == [ 0, 5, 10 ], n_dropped)
+end
+
+# Test that FIXED_UPDATE can only be given once.
+@bp_check(try
+              macroexpand(@__MODULE__, :(
+                  @game_loop begin
+                      FIXED_UPDATE = nothing
+                      FIXED_UPDATE = nothing
+                      LOOP = nothing
+                  end
+              ))
+              false
+          catch e
+              occursin("Provided FIXED_UPDATE more than once", sprint(showerror, e))
+          end,
+          "Giving FIXED_UPDATE twice should be an error")
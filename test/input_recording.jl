@@ -0,0 +1,18 @@
+# Test that input recordings survive a trip to disk.
+let path = joinpath(tempdir(), "Bplus_test_InputRecording.bin"),
+    recording = InputRecording([
+        Dict("jump" => true, "move" => 0.5f0),
+        Dict{String, Union{Bool, Float32}}(),
+        Dict("jump" => false, "move" => -1.0f0, "look" => 3.25f0)
+    ])
+    try
+        save_input_recording(path, recording)
+        loaded = load_input_recording(path)
+        @bp_check(loaded.frames == recording.frames,
+                  "Expected ", recording.frames, ", got ", loaded.frames)
+        @bp_check(loaded.frames[1]["jump"] isa Bool)
+        @bp_check(loaded.frames[3]["look"] isa Float32)
+    finally
+        rm(path, force=true)
+    end
+end
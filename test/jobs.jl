@@ -0,0 +1,47 @@
+const JOBS_POOL = JobPool(3)
+
+# Test that dependencies run in order, like a frame's worth of work.
+let log = Vector{Symbol}(),
+    log_lock = ReentrantLock()
+    record(s) = lock(() -> push!(log, s), log_lock)
+
+    physics = add_job!(() -> record(:physics), JOBS_POOL)
+    transforms = add_job!(() -> record(:transforms), JOBS_POOL, physics)
+    culling_a = add_job!(() -> record(:culling), JOBS_POOL, transforms)
+    culling_b = add_job!(() -> record(:culling), JOBS_POOL, transforms)
+    upload = add_job!(() -> record(:upload), JOBS_POOL, culling_a, culling_b)
+    wait(upload)
+
+    @bp_check(log == [ :physics, :transforms, :culling, :culling, :upload ], log)
+    @bp_check(all(is_finished, (physics, transforms, culling_a, culling_b, upload)))
+
+    # Depending on an already-finished job shouldn't block.
+    late = add_job!(() -> record(:late), JOBS_POOL, upload)
+    wait(late)
+    @bp_check(log[end] == :late, log)
+end
+
+# Test that errors propagate through the graph, skipping dependent jobs.
+let ran_dependent = Threads.Atomic{Bool}(false)
+    failing = add_job!(() -> error("Oops"), JOBS_POOL)
+    dependent = add_job!(() -> (ran_dependent[] = true), JOBS_POOL, failing)
+    @bp_check(try
+                  wait(dependent)
+                  false
+              catch e
+                  e isa CapturedException
+              end,
+              "Waiting on a failed dependency should rethrow its error")
+    @bp_check(!ran_dependent[], "A job ran even though its dependency failed")
+end
+
+# Test parallel-for, with automatic and manual grain sizes.
+for grain_size in (nothing, 1, 7, 10_000)
+    counts = zeros(Int, 1000)
+    parallel_for(i -> (counts[i] += i), JOBS_POOL, 1:1000; grain_size=grain_size)
+    @bp_check(counts == 1:1000, "Grain size ", grain_size, ": ", counts)
+end
+@bp_check(wait(add_parallel_for!(i -> nothing, JOBS_POOL, 1:0)) === nothing,
+          "Parallel-for over an empty range should finish immediately")
+
+close(JOBS_POOL)
@@ -0,0 +1,63 @@
+# Test the registry itself, with a custom category.
+let u = memory_usage(:test_memory)
+    @bp_check(u.live_bytes == 0 && u.live_count == 0 && isnothing(u.budget_bytes), u)
+end
+track_memory!(:test_memory, 100)
+track_memory!(:test_memory, 50)
+untrack_memory!(:test_memory, 100)
+let u = memory_usage(:test_memory)
+    @bp_check(u.live_bytes == 50, u)
+    @bp_check(u.live_count == 1, u)
+    @bp_check(u.peak_bytes == 150, u)
+    @bp_check(u.total_count == 2, u)
+end
+@bp_check(haskey(memory_usage(), :test_memory))
+
+# Test budgets.
+set_memory_budget!(:test_memory, 40)
+@bp_check(is_over_budget(memory_usage(:test_memory)))
+@bp_check(:test_memory in memory_over_budget())
+set_memory_budget!(:test_memory, 1000)
+@bp_check(!(:test_memory in memory_over_budget()))
+set_memory_budget!(:test_memory, nothing)
+@bp_check(isnothing(memory_usage(:test_memory).budget_bytes))
+
+# Test tracking from many threads at once.
+let n_per_task = 10_000
+    tasks = [ Threads.@spawn(for _ in 1:n_per_task
+                                 track_memory!(:test_memory_threaded, 8)
+                             end)
+              for _ in 1:4 ]
+    foreach(wait, tasks)
+    u = memory_usage(:test_memory_threaded)
+    @bp_check(u.live_bytes == 8 * 4 * n_per_task, u)
+    @bp_check(u.live_count == 4 * n_per_task, u)
+end
+
+# Registering categories from many threads at once shouldn't lose any of them, or their counts.
+let names = [ Symbol(:test_memory_registered_, i) for i in 1:32 ]
+    tasks = [ Threads.@spawn(for name in names
+                                 track_memory!(name, 1)
+                             end)
+              for _ in 1:4 ]
+    foreach(wait, tasks)
+    usage = memory_usage()
+    for name in names
+        @bp_check(haskey(usage, name), name)
+        @bp_check(usage[name].live_count == 4, name, ": ", usage[name])
+    end
+end
+
+# Test the ECS hooks: every component that's created and destroyed should be accounted for.
+@component MemoryTrackedComponent begin
+    i::Int
+end
+let world = World(),
+    n_live_before = memory_usage(:ecs_components).live_count
+    entity = add_entity(world)
+    c = add_component(entity, MemoryTrackedComponent)
+    @bp_check(memory_usage(:ecs_components).live_count == n_live_before + 1)
+    remove_component(entity, c)
+    @bp_check(memory_usage(:ecs_components).live_count == n_live_before,
+              "Leaked a component in the memory tracker")
+end
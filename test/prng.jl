@@ -138,6 +138,37 @@ orderings = map(i -> collect(RandIterator(1000)),
 @bp_check(allunique(orderings),
           "RandIterator(1000) managed to generate the same sequence more than once; this is virtually impossible with proper randomness")
 
+# Test partitioning a RandIterator.
+for n in (1, 7, 200, 1000, 4097)
+    for k in (1, 2, 3, 8, 64)
+        it = RandIterator(n, ConstPRNG(n, k))
+        partitions = map(i -> collect(RandIteratorPartition(it, i, k)), 1:k)
+        @bp_check(sort(vcat(partitions...)) == 1:n,
+                  "Partitioning RandIterator(", n, ") ", k, " ways doesn't cover 1:", n)
+        @bp_check(vcat(partitions...) == collect(it),
+                  "Partitions of RandIterator(", n, ") aren't pieces of the original sequence")
+        if n >= 1000 && k <= 8
+            @bp_check(all(p -> abs(length(p) - (n / k)) < (n / k) * 0.5, partitions),
+                      "Unbalanced partitions of RandIterator(", n, "): ", map(length, partitions))
+        end
+    end
+end
+@bp_test_no_allocations_setup(
+    begin
+        it = RandIterator(500)
+    end,
+    begin
+        total::Int = 0
+        for i in 1:4
+            for x in RandIteratorPartition(it, i, 4)
+                total += x
+            end
+        end
+        total
+    end,
+    sum(1:500)
+)
+
 const prng = PRNG(0x1234567)
 const prng2 = PRNG(0x1234567)
 
@@ -0,0 +1,54 @@
+# Test that zones are recorded, including nested zones and early exits.
+clear_profile!()
+function profiled_func(x)
+    @bp_profile "outer" begin
+        @bp_profile "inner" begin
+            x += 1
+        end
+        if x > 10
+            return x
+        end
+        x *= 2
+    end
+    return x
+end
+@bp_check(profiled_func(1) == 4)
+@bp_check(profiled_func(20) == 21)
+@bp_check(try
+              @bp_profile "throws" error("Oops")
+              false
+          catch
+              true
+          end)
+
+zones = profile_zones()
+@bp_check(map(profile_zone_name, zones) == [ "outer", "inner", "outer", "inner", "throws" ],
+          map(profile_zone_name, zones))
+@bp_check(all(z -> z.end_ns >= z.start_ns, zones))
+# The inner zone should be entirely contained within the outer zone.
+@bp_check(zones[1].start_ns <= zones[2].start_ns)
+@bp_check(zones[1].end_ns >= zones[2].end_ns)
+
+# Test Chrome trace export.
+trace = sprint(export_chrome_trace)
+@bp_check(startswith(trace, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), trace)
+@bp_check(count("\"ph\":\"X\"", trace) == 5, trace)
+@bp_check(occursin("\"name\":\"inner\"", trace), trace)
+
+# Test the function-definition form, including doc-strings and early returns.
+clear_profile!()
+"A profiled function"
+@bp_profile "whole_func" function profiled_whole_func(x::Int; y::Int = 1)::Int
+    if x < 0
+        return y
+    end
+    return x + y
+end
+@bp_check(profiled_whole_func(-1) == 1)
+@bp_check(profiled_whole_func(3; y=2) == 5)
+@bp_check(map(profile_zone_name, profile_zones()) == [ "whole_func", "whole_func" ],
+          map(profile_zone_name, profile_zones()))
+@bp_check(occursin("A profiled function", string(@doc profiled_whole_func)))
+
+clear_profile!()
+@bp_check(isempty(profile_zones()))
@@ -0,0 +1,94 @@
+# Test basic single-threaded behavior, for both kinds of queue.
+for TQueue in (SpscQueue, MpmcQueue)
+    q = TQueue{Int}(5)
+    @bp_check(queue_capacity(q) == 8, "Capacity should round up to a power of 2: ", queue_capacity(q))
+    @bp_check(isempty(q))
+    @bp_check(isnothing(try_pop!(q)))
+
+    # Fill it up, then empty it, a few times to make sure it wraps around properly.
+    for lap in 1:3
+        for i in 1:8
+            @bp_check(try_push!(q, i * lap), TQueue, ": lap ", lap, ", element ", i)
+        end
+        @bp_check(!try_push!(q, -1), TQueue, " should be full on lap ", lap)
+        @bp_check(length(q) == 8)
+        for i in 1:8
+            @bp_check(try_pop!(q) == i * lap, TQueue, ": lap ", lap, ", element ", i)
+        end
+        @bp_check(isnothing(try_pop!(q)))
+    end
+
+    # Test the batch API.
+    @bp_check(try_push_batch!(q, 1:5) == 5)
+    @bp_check(try_push_batch!(q, 6:10) == 3, "Only 3 elements should have fit")
+    output = zeros(Int, 20)
+    @bp_check(try_pop_batch!(q, output, 2) == 2)
+    @bp_check(output[1:2] == [ 1, 2 ], output[1:2])
+    @bp_check(try_pop_batch!(q, output) == 6)
+    @bp_check(output[1:6] == 3:8, output[1:6])
+    @bp_check(try_pop_batch!(q, output) == 0)
+
+    # Pushing and popping isbits data shouldn't allocate.
+    @bp_test_no_allocations(try_push!(q, 3) && (try_pop!(q) == 3), true,
+                            "Pushing/popping ", TQueue)
+    @bp_test_no_allocations_setup(
+        buffer = zeros(Int, 4),
+        (try_push_batch!(q, 1:4) == 4) && (try_pop_batch!(q, buffer) == 4),
+        true,
+        "Batch pushing/popping ", TQueue
+    )
+end
+
+# Queues shouldn't keep popped references alive.
+for (q, slots) in ((SpscQueue{String}(2), q -> q.buffer),
+                   (MpmcQueue{String}(2), q -> q.values))
+    @bp_check(try_push!(q, "a") && try_push!(q, "b"))
+    @bp_check(try_pop!(q) == "a")
+    @bp_check(isnothing(slots(q)[1]), typeof(q), ": ", slots(q))
+    output = String[ "" ]
+    @bp_check(try_pop_batch!(q, output) == 1)
+    @bp_check(output == [ "b" ], output)
+    @bp_check(all(isnothing, slots(q)), typeof(q), ": ", slots(q))
+end
+
+# Test with concurrent producers and consumers.
+# Even with only one thread, the tasks will interleave, as they yield whenever they stall.
+const N_QUEUE_ELEMENTS = 100_000
+function run_queue_threads(q, n_producers::Int, n_consumers::Int)::Vector{Int}
+    per_producer = N_QUEUE_ELEMENTS ÷ n_producers
+    producers = map(1:n_producers) do p_i
+        Threads.@spawn for i in 1:per_producer
+            while !try_push!(q, ((p_i - 1) * per_producer) + i)
+                yield()
+            end
+        end
+    end
+
+    n_popped = Threads.Atomic{Int}(0)
+    consumers = map(1:n_consumers) do c_i
+        Threads.@spawn begin
+            received = Int[ ]
+            while n_popped[] < (per_producer * n_producers)
+                x = try_pop!(q)
+                if isnothing(x)
+                    yield()
+                else
+                    push!(received, x)
+                    Threads.atomic_add!(n_popped, 1)
+                end
+            end
+            received
+        end
+    end
+
+    foreach(wait, producers)
+    return sort!(vcat(fetch.(consumers)...))
+end
+let results = run_queue_threads(SpscQueue{Int}(64), 1, 1)
+    @bp_check(results == 1:N_QUEUE_ELEMENTS,
+              "SpscQueue lost or duplicated elements: got ", length(results))
+end
+let results = run_queue_threads(MpmcQueue{Int}(64), 4, 4)
+    @bp_check(results == 1:N_QUEUE_ELEMENTS,
+              "MpmcQueue lost or duplicated elements: got ", length(results))
+end
@@ -31,6 +31,10 @@ eval(TESTS_DEPENDENCIES)
 @inline Bplus.Helpers.bp_helpers_asserts_enabled() = true
 @inline Bplus.SceneTree.bp_scene_tree_asserts_enabled() = true
 @inline Bplus.GUI.bp_gui_asserts_enabled() = true
+# Enable profiler zones too, so they get exercised.
+@inline Bplus.Utilities.bp_profiling_enabled() = true
+# Enable memory tracking, so its hooks get exercised.
+@inline Bplus.Utilities.bp_memory_tracking_enabled() = true
 
 
 #############################